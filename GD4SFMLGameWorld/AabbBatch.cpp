@@ -0,0 +1,191 @@
+#include "AabbBatch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+// Define AABB_BATCH_NO_SIMD to build the scalar kernel only
+#if !defined(AABB_BATCH_NO_SIMD) && defined(__AVX512F__)
+#define AABB_BATCH_AVX512
+#include <immintrin.h>
+#elif !defined(AABB_BATCH_NO_SIMD) && defined(__AVX__)
+#define AABB_BATCH_AVX
+#include <immintrin.h>
+#elif !defined(AABB_BATCH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define AABB_BATCH_SSE
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// Each array starts on a cache line, and capacities are kept to a multiple of the widest register
+	const std::size_t Alignment = 64;
+	const std::size_t Lanes = Alignment / sizeof(float);
+
+	void appendMask(unsigned int mask, std::size_t first, std::vector<std::size_t>& overlaps)
+	{
+		for (std::size_t lane = first; mask != 0; ++lane, mask >>= 1)
+		{
+			if (mask & 1u)
+				overlaps.push_back(lane);
+		}
+	}
+}
+
+AabbBatch::AabbBatch()
+	: mStorage()
+	, mMinX(nullptr)
+	, mMinY(nullptr)
+	, mMaxX(nullptr)
+	, mMaxY(nullptr)
+	, mSize(0)
+	, mCapacity(0)
+{
+}
+
+void AabbBatch::clear()
+{
+	mSize = 0;
+}
+
+void AabbBatch::resize(std::size_t size)
+{
+	reserve(size);
+	mSize = size;
+}
+
+void AabbBatch::push(const sf::FloatRect& rect)
+{
+	reserve(mSize + 1);
+	set(mSize++, rect);
+}
+
+void AabbBatch::set(std::size_t index, const sf::FloatRect& rect)
+{
+	// Same float arithmetic as sf::FloatRect::intersects, so the results match it exactly
+	mMinX[index] = rect.left;
+	mMinY[index] = rect.top;
+	mMaxX[index] = rect.left + rect.width;
+	mMaxY[index] = rect.top + rect.height;
+}
+
+void AabbBatch::swapRemove(std::size_t index)
+{
+	--mSize;
+	mMinX[index] = mMinX[mSize];
+	mMinY[index] = mMinY[mSize];
+	mMaxX[index] = mMaxX[mSize];
+	mMaxY[index] = mMaxY[mSize];
+}
+
+std::size_t AabbBatch::size() const
+{
+	return mSize;
+}
+
+void AabbBatch::findOverlaps(std::size_t index, std::size_t begin, std::size_t end, std::vector<std::size_t>& overlaps) const
+{
+	findOverlaps(mMinX[index], mMinY[index], mMaxX[index], mMaxY[index], begin, end, overlaps);
+}
+
+void AabbBatch::findOverlaps(const sf::FloatRect& rect, std::size_t begin, std::size_t end, std::vector<std::size_t>& overlaps) const
+{
+	findOverlaps(rect.left, rect.top, rect.left + rect.width, rect.top + rect.height, begin, end, overlaps);
+}
+
+const char* AabbBatch::getKernelName()
+{
+#if defined(AABB_BATCH_AVX512)
+	return "AVX-512";
+#elif defined(AABB_BATCH_AVX)
+	return "AVX";
+#elif defined(AABB_BATCH_SSE)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+void AabbBatch::reserve(std::size_t capacity)
+{
+	if (capacity <= mCapacity)
+		return;
+
+	std::size_t newCapacity = std::max(capacity, 2 * mCapacity);
+	newCapacity = (newCapacity + Lanes - 1) / Lanes * Lanes;
+
+	std::vector<float> storage(4 * newCapacity + Lanes);
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(storage.data());
+	float* base = storage.data() + ((Alignment - address % Alignment) % Alignment) / sizeof(float);
+
+	if (mSize > 0)
+	{
+		std::copy(mMinX, mMinX + mSize, base);
+		std::copy(mMinY, mMinY + mSize, base + newCapacity);
+		std::copy(mMaxX, mMaxX + mSize, base + 2 * newCapacity);
+		std::copy(mMaxY, mMaxY + mSize, base + 3 * newCapacity);
+	}
+
+	mStorage.swap(storage);
+	mMinX = base;
+	mMinY = base + newCapacity;
+	mMaxX = base + 2 * newCapacity;
+	mMaxY = base + 3 * newCapacity;
+	mCapacity = newCapacity;
+}
+
+void AabbBatch::findOverlaps(float minX, float minY, float maxX, float maxY, std::size_t begin, std::size_t end, std::vector<std::size_t>& overlaps) const
+{
+	// Both boxes are non-empty, so two strict compares per axis are all sf::FloatRect::intersects boils down to
+	std::size_t i = begin;
+
+#if defined(AABB_BATCH_AVX512)
+	const __m512 queryMinX = _mm512_set1_ps(minX);
+	const __m512 queryMinY = _mm512_set1_ps(minY);
+	const __m512 queryMaxX = _mm512_set1_ps(maxX);
+	const __m512 queryMaxY = _mm512_set1_ps(maxY);
+	for (; i + 16 <= end; i += 16)
+	{
+		__mmask16 mask = _mm512_cmp_ps_mask(queryMinX, _mm512_loadu_ps(mMaxX + i), _CMP_LT_OQ);
+		mask = _mm512_mask_cmp_ps_mask(mask, _mm512_loadu_ps(mMinX + i), queryMaxX, _CMP_LT_OQ);
+		mask = _mm512_mask_cmp_ps_mask(mask, queryMinY, _mm512_loadu_ps(mMaxY + i), _CMP_LT_OQ);
+		mask = _mm512_mask_cmp_ps_mask(mask, _mm512_loadu_ps(mMinY + i), queryMaxY, _CMP_LT_OQ);
+		if (mask != 0)
+			appendMask(mask, i, overlaps);
+	}
+#elif defined(AABB_BATCH_AVX)
+	const __m256 queryMinX = _mm256_set1_ps(minX);
+	const __m256 queryMinY = _mm256_set1_ps(minY);
+	const __m256 queryMaxX = _mm256_set1_ps(maxX);
+	const __m256 queryMaxY = _mm256_set1_ps(maxY);
+	for (; i + 8 <= end; i += 8)
+	{
+		__m256 x = _mm256_and_ps(_mm256_cmp_ps(queryMinX, _mm256_loadu_ps(mMaxX + i), _CMP_LT_OQ), _mm256_cmp_ps(_mm256_loadu_ps(mMinX + i), queryMaxX, _CMP_LT_OQ));
+		__m256 y = _mm256_and_ps(_mm256_cmp_ps(queryMinY, _mm256_loadu_ps(mMaxY + i), _CMP_LT_OQ), _mm256_cmp_ps(_mm256_loadu_ps(mMinY + i), queryMaxY, _CMP_LT_OQ));
+		int mask = _mm256_movemask_ps(_mm256_and_ps(x, y));
+		if (mask != 0)
+			appendMask(static_cast<unsigned int>(mask), i, overlaps);
+	}
+#elif defined(AABB_BATCH_SSE)
+	const __m128 queryMinX = _mm_set1_ps(minX);
+	const __m128 queryMinY = _mm_set1_ps(minY);
+	const __m128 queryMaxX = _mm_set1_ps(maxX);
+	const __m128 queryMaxY = _mm_set1_ps(maxY);
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 x = _mm_and_ps(_mm_cmplt_ps(queryMinX, _mm_loadu_ps(mMaxX + i)), _mm_cmplt_ps(_mm_loadu_ps(mMinX + i), queryMaxX));
+		__m128 y = _mm_and_ps(_mm_cmplt_ps(queryMinY, _mm_loadu_ps(mMaxY + i)), _mm_cmplt_ps(_mm_loadu_ps(mMinY + i), queryMaxY));
+		int mask = _mm_movemask_ps(_mm_and_ps(x, y));
+		if (mask != 0)
+			appendMask(static_cast<unsigned int>(mask), i, overlaps);
+	}
+#endif
+
+	// Scalar fallback, also handles the leftover boxes of the vector loops.
+	// The compares are combined without short-circuiting so the compiler can keep them branch-free
+	for (; i < end; ++i)
+	{
+		bool overlapping = (minX < mMaxX[i]) & (mMinX[i] < maxX) & (minY < mMaxY[i]) & (mMinY[i] < maxY);
+		if (overlapping)
+			overlaps.push_back(i);
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <vector>
+
+// Axis aligned boxes packed into separate min-x/min-y/max-x/max-y arrays,
+// so that one box can be tested against a whole range of them with SIMD compares.
+// Boxes are expected to be non-empty, which the broadphase guarantees.
+class AabbBatch : private sf::NonCopyable
+{
+public:
+	AabbBatch();
+
+	void clear();
+	void resize(std::size_t size);
+	void push(const sf::FloatRect& rect);
+	void set(std::size_t index, const sf::FloatRect& rect);
+	void swapRemove(std::size_t index);
+	std::size_t size() const;
+
+	// Append the indices in [begin, end) whose box overlaps the given one, in increasing order
+	void findOverlaps(std::size_t index, std::size_t begin, std::size_t end, std::vector<std::size_t>& overlaps) const;
+	void findOverlaps(const sf::FloatRect& rect, std::size_t begin, std::size_t end, std::vector<std::size_t>& overlaps) const;
+
+	static const char* getKernelName();
+
+private:
+	void reserve(std::size_t capacity);
+	void findOverlaps(float minX, float minY, float maxX, float maxY, std::size_t begin, std::size_t end, std::vector<std::size_t>& overlaps) const;
+
+private:
+	std::vector<float> mStorage;
+	float* mMinX;
+	float* mMinY;
+	float* mMaxX;
+	float* mMaxY;
+	std::size_t mSize;
+	std::size_t mCapacity;
+};
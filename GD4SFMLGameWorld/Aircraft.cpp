@@ -5,6 +5,8 @@
 #include "Pickup.hpp"
 #include "CommandQueue.hpp"
 #include "SoundNode.hpp"
+#include "EntityTable.hpp"
+#include "SteeringBatch.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include "SFML/Graphics/RenderStates.hpp"
@@ -35,81 +37,81 @@ namespace
 
 Aircraft::Aircraft(PersonID type, const TextureHolder& textures, const FontHolder& fonts)
 	: Entity(Table[static_cast<int>(type)].hitpoints)
-	, mType(type)
+	, mTextures(textures)
 	, mSprite(textures.get(Table[static_cast<int>(type)].texture), Table[static_cast<int>(type)].textureRect)
-	, mBloodSplat(textures.get(TextureID::BloodSplat))
-	, mFireCommand()
-	, mMissileCommand()
-	, mFireCountdown(sf::Time::Zero)
-	, mIsFiring(false)
-	, mIsLaunchingMissile(false)
-	, mShowBloodSplat(true)
-	, mPlayedBloodSplatSound(false)
-	, mSpawnedPickup(false)
-	, mIsMarkedForRemoval(false)
-	, mFireRateLevel(1)
-	, mSpreadLevel(1)
-	, mMissileAmmo(2)
-	, mDropPickupCommand()
-	, mTravelledDistance(0.f)
-	, mDirectionIndex(0)
 	, mHealthDisplay(nullptr)
-	, mMissileDisplay(nullptr)
+	, mPlayerState()
+	, mDeathState()
+	, mFireCountdown(sf::Time::Zero)
+	, mHeading(0.f, -1.f)
 	, mTargetDirection()
+	, mDirectionIndex(0)
+	, mTravelledDistance(0.f)
+	, mDisplayedHitpoints(-1)
+	, mType(type)
+	, mIsFiring(false)
 {
-	mBloodSplat.setFrameSize(sf::Vector2i(256, 256));
-	mBloodSplat.setNumFrames(16);
-	mBloodSplat.setDuration(sf::seconds(1));
-
 	centreOrigin(mSprite);
-	centreOrigin(mBloodSplat);
-
-	mFireCommand.category = static_cast<int>(CategoryID::SceneAirLayer);
-	mFireCommand.action = [this, &textures](SceneNode& node, sf::Time)
-	{
-		createBullets(node, textures);
-	};
-
-	mMissileCommand.category = static_cast<int>(CategoryID::SceneAirLayer);
-	mMissileCommand.action = [this, &textures](SceneNode& node, sf::Time)
-	{
-		createProjectile(node, ProjectileID::Missile, 0.f, 0.5f, textures);
-	};
-
-	mDropPickupCommand.category = static_cast<int>(CategoryID::SceneAirLayer);
-	mDropPickupCommand.action = [this, &textures](SceneNode& node, sf::Time)
-	{
-		createPickup(node, textures);
-	};
 
 	std::unique_ptr<TextNode> healthDisplay(new TextNode(fonts, ""));
 	mHealthDisplay = healthDisplay.get();
+	mHealthDisplay->setUpright(true);
 	attachChild(std::move(healthDisplay));
 
-	if (getCategory() == (static_cast<int>(CategoryID::PlayerAircraft)))
-	{
-		std::unique_ptr<TextNode> missileDisplay(new TextNode(fonts, ""));
-		missileDisplay->setPosition(0, 70);
-		mMissileDisplay = missileDisplay.get();
-		attachChild(std::move(missileDisplay));
-	}
-	
-	if (getCategory() == (static_cast<int>(CategoryID::Player2Aircraft)))
+	if (isAllied() || isAllied2())
 	{
+		mPlayerState.reset(new PlayerState());
+
 		std::unique_ptr<TextNode> missileDisplay(new TextNode(fonts, ""));
 		missileDisplay->setPosition(0, 70);
-		mMissileDisplay = missileDisplay.get();
+		mPlayerState->missileDisplay = missileDisplay.get();
 		attachChild(std::move(missileDisplay));
 	}
 
 	updateTexts();
 }
 
+Aircraft::PlayerState::PlayerState()
+	: missileDisplay(nullptr)
+	, missileAmmo(2)
+	, displayedMissileAmmo(-1)
+	, fireRateLevel(1)
+	, spreadLevel(1)
+	, isLaunchingMissile(false)
+{
+}
+
+Aircraft::DeathState::DeathState(const TextureHolder& textures)
+	: bloodSplat(textures.get(TextureID::BloodSplat))
+	, playedSound(false)
+	, spawnedPickup(false)
+{
+	bloodSplat.setFrameSize(sf::Vector2i(256, 256));
+	bloodSplat.setNumFrames(16);
+	bloodSplat.setDuration(sf::seconds(1));
+	centreOrigin(bloodSplat);
+}
+
+std::size_t Aircraft::getPlayerStateSize()
+{
+	return sizeof(PlayerState);
+}
+
+std::size_t Aircraft::getDeathStateSize()
+{
+	return sizeof(DeathState);
+}
+
+ObjectPool& Aircraft::getDeathStatePool()
+{
+	return DeathState::getPool();
+}
+
 
 void Aircraft::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	if (isDestroyed() && mShowBloodSplat)
-		target.draw(mBloodSplat, states);
+	if (isDestroyed() && mDeathState)
+		target.draw(mDeathState->bloodSplat, states);
 	else
 		target.draw(mSprite, states);
 }
@@ -119,16 +121,19 @@ void Aircraft::updateCurrent(sf::Time dt, CommandQueue& commands)
 	// Entity has been destroyed: Possibly drop pickup, mark for removal
 	if (isDestroyed())
 	{
+		if (!mDeathState)
+			mDeathState.reset(new DeathState(mTextures));
+
 		checkPickupDrop(commands);
-		mBloodSplat.update(dt);
+		mDeathState->bloodSplat.update(dt);
 		//mIsMarkedForRemoval = true;
 		//Play BloodSplat sound
-		if (!mPlayedBloodSplatSound)
+		if (!mDeathState->playedSound)
 		{
 			SoundEffectID soundEffect = (randomInt(2) == 0) ? SoundEffectID::Explosion1 : SoundEffectID::Explosion2;
 			playerLocalSound(commands, soundEffect);
 
-			mPlayedBloodSplatSound = true;
+			mDeathState->playedSound = true;
 		}
 		return;
 	}
@@ -136,20 +141,7 @@ void Aircraft::updateCurrent(sf::Time dt, CommandQueue& commands)
 	// Check if bullets or missiles are fired
 	checkProjectileLaunch(dt, commands);
 
-	// Update enemy movement pattern; apply velocity
-	updateMovementPattern(dt);
-	if (isGuided())
-	{
-		const float approachRate = 100.f;
-
-		sf::Vector2f newVelocity = unitVector(approachRate * dt.asSeconds() * mTargetDirection + getVelocity());
-		newVelocity *= getMaxSpeed();
-		float angle = std::atan2(newVelocity.y, newVelocity.x);
-
-		setRotation(toDegree(angle) + 90.f);
-		setVelocity(newVelocity);
-	}
-
+	// The movement pattern and guidance are applied by World::steerEnemies(), for all enemies at once
 	Entity::updateCurrent(dt, commands);
 
 	// Update texts
@@ -173,9 +165,19 @@ sf::FloatRect Aircraft::getBoundingRect() const
 	return getWorldTransform().transformRect(mSprite.getGlobalBounds());
 }
 
+const CollisionShape* Aircraft::getCollisionShape() const
+{
+	return &Table[static_cast<int>(mType)].shape;
+}
+
+const sf::Sprite* Aircraft::getCollisionSprite() const
+{
+	return &mSprite;
+}
+
 bool Aircraft::isMarkedForRemoval() const
 {
-	return isDestroyed() && (mBloodSplat.isFinished() || !mShowBloodSplat);
+	return isDestroyed() && mDeathState && mDeathState->bloodSplat.isFinished();
 }
 
 bool Aircraft::isAllied() const
@@ -195,33 +197,30 @@ float Aircraft::getMaxSpeed() const
 
 void Aircraft::increaseFireRate()
 {
-	if (mFireRateLevel < 10)
-		++mFireRateLevel;
+	if (mPlayerState && mPlayerState->fireRateLevel < 10)
+		++mPlayerState->fireRateLevel;
 }
 
 void Aircraft::increaseSpread()
 {
-	if (mSpreadLevel < 3)
-		++mSpreadLevel;
+	if (mPlayerState && mPlayerState->spreadLevel < 3)
+		++mPlayerState->spreadLevel;
 }
 
 void Aircraft::collectMissiles(unsigned int count)
 {
-	mMissileAmmo += count;
+	if (mPlayerState)
+		mPlayerState->missileAmmo += count;
 }
 
 void Aircraft::playerLocalSound(CommandQueue& commands, SoundEffectID effect)
 {
 	sf::Vector2f worldPosition = getWorldPosition();
 
-	Command command;
-	command.category = static_cast<int>(CategoryID::SoundEffect);
-	command.action = derivedAction<SoundNode>(
-		[effect, worldPosition](SoundNode& node, sf::Time)
+	commands.push(typedCommand<SoundNode>([effect, worldPosition](SoundNode& node, sf::Time)
 	{
 		node.playSound(effect, worldPosition);
-	});
-	commands.push(command);
+	}));
 }
 
 void Aircraft::fire()
@@ -233,16 +232,27 @@ void Aircraft::fire()
 
 void Aircraft::launchMissile()
 {
-	if (mMissileAmmo > 0)
+	if (mPlayerState && mPlayerState->missileAmmo > 0)
 	{
-		mIsLaunchingMissile = true;
-		--mMissileAmmo;
+		mPlayerState->isLaunchingMissile = true;
+		--mPlayerState->missileAmmo;
 	}
 }
 
-void Aircraft::updateMovementPattern(sf::Time dt)
+void Aircraft::applyInput(const PlayerInput& input)
+{
+	accelerate(input.getMovement() * getMaxSpeed());
+
+	if (input.isPressed(InputButtonID::Fire))
+		fire();
+	if (input.isPressed(InputButtonID::LaunchMissile))
+		launchMissile();
+}
+
+void Aircraft::pushSteering(SteeringBatch& batch, sf::Time dt)
 {
 	// Enemy airplane: Movement pattern
+	sf::Vector2f velocity = getVelocity();
 	const std::vector<Direction>& directions = Table[static_cast<int>(mType)].directions;
 	if (!directions.empty())
 	{
@@ -253,16 +263,43 @@ void Aircraft::updateMovementPattern(sf::Time dt)
 			mTravelledDistance = 0.f;
 		}
 
-		// Compute velocity from direction
-		float radians = toRadian(directions[mDirectionIndex].angle + 90.f);
-		float vx = getMaxSpeed() * std::cos(radians);
-		float vy = getMaxSpeed() * std::sin(radians);
-
-		setVelocity(vx, vy);
+		// Velocity from the precomputed direction
+		velocity = getMaxSpeed() * directions[mDirectionIndex].unit;
 
 		mTravelledDistance += getMaxSpeed() * dt.asSeconds();
 	}
-	
+
+	// Guided enemies turn towards the target at full speed
+	std::size_t component = getEntityTable()->getComponent(*this);
+	if (isGuided())
+	{
+		const float approachRate = 100.f;
+		batch.push(component, velocity, approachRate * dt.asSeconds() * mTargetDirection, getMaxSpeed());
+	}
+	else
+	{
+		batch.push(component, velocity, sf::Vector2f(), 0.f);
+	}
+}
+
+void Aircraft::setHeading(sf::Vector2f heading)
+{
+	mHeading = heading;
+	invalidateWorldTransform();
+}
+
+void Aircraft::faceVelocity()
+{
+	// Steered aircraft move at full speed, so this is the unit vector without a square root
+	setHeading(getVelocity() / getMaxSpeed());
+}
+
+sf::Transform Aircraft::getLocalTransform() const
+{
+	// The sprite faces up, turning it to the heading is the rotation whose cosine and sine are -heading.y and heading.x.
+	// Children turn along, only the texts are kept upright.
+	sf::Transform rotation(-mHeading.y, -mHeading.x, 0.f, mHeading.x, -mHeading.y, 0.f, 0.f, 0.f, 1.f);
+	return Entity::getLocalTransform() * rotation;
 }
 
 void Aircraft::guideTowards(sf::Vector2f position)
@@ -278,9 +315,18 @@ bool Aircraft::isGuided() const
 
 void Aircraft::checkPickupDrop(CommandQueue& commands)
 {
-	if (!isAllied() && randomInt(3) == 0 && !mSpawnedPickup)
-		commands.push(mDropPickupCommand);
-	mSpawnedPickup = true;
+	if (!isAllied() && randomInt(3) == 0 && !mDeathState->spawnedPickup)
+	{
+		// The command runs next tick, by then the aircraft may be gone: resolve it through its handle
+		EntityTable* table = getEntityTable();
+		EntityHandle handle = getHandle();
+		commands.push(typedCommand<SceneNode>(static_cast<int>(CategoryID::SceneAirLayer), [table, handle](SceneNode& node, sf::Time)
+		{
+			if (const Aircraft* aircraft = table->get<Aircraft>(handle))
+				aircraft->createPickup(node, aircraft->mTextures);
+		}));
+	}
+	mDeathState->spawnedPickup = true;
 }
 
 void Aircraft::checkProjectileLaunch(sf::Time dt, CommandQueue& commands)
@@ -293,9 +339,15 @@ void Aircraft::checkProjectileLaunch(sf::Time dt, CommandQueue& commands)
 	if (mIsFiring && mFireCountdown <= sf::Time::Zero)
 	{
 		// Interval expired: We can fire a new bullet
-		commands.push(mFireCommand);
+		EntityTable* table = getEntityTable();
+		EntityHandle handle = getHandle();
+		commands.push(typedCommand<SceneNode>(static_cast<int>(CategoryID::SceneAirLayer), [table, handle](SceneNode& node, sf::Time)
+		{
+			if (const Aircraft* aircraft = table->get<Aircraft>(handle))
+				aircraft->createBullets(node, aircraft->mTextures);
+		}));
 		playerLocalSound(commands, isAllied() ? SoundEffectID::AlliedGunfire : SoundEffectID::EnemyGunfire);
-		mFireCountdown += Table[static_cast<int>(mType)].fireInterval / (mFireRateLevel + 1.f);
+		mFireCountdown += Table[static_cast<int>(mType)].fireInterval / (getFireRateLevel() + 1.f);
 		mIsFiring = false;
 	}
 	else if (mFireCountdown > sf::Time::Zero)
@@ -306,11 +358,17 @@ void Aircraft::checkProjectileLaunch(sf::Time dt, CommandQueue& commands)
 	}
 
 	// Check for missile launch
-	if (mIsLaunchingMissile)
+	if (mPlayerState && mPlayerState->isLaunchingMissile)
 	{
-		commands.push(mMissileCommand);
+		EntityTable* table = getEntityTable();
+		EntityHandle handle = getHandle();
+		commands.push(typedCommand<SceneNode>(static_cast<int>(CategoryID::SceneAirLayer), [table, handle](SceneNode& node, sf::Time)
+		{
+			if (const Aircraft* aircraft = table->get<Aircraft>(handle))
+				aircraft->createProjectile(node, ProjectileID::Missile, 0.f, 0.5f, aircraft->mTextures);
+		}));
 		playerLocalSound(commands, SoundEffectID::LaunchMissile);
-		mIsLaunchingMissile = false;
+		mPlayerState->isLaunchingMissile = false;
 	}
 }
 
@@ -318,7 +376,7 @@ void Aircraft::createBullets(SceneNode& node, const TextureHolder& textures) con
 {
 	ProjectileID type = isAllied() || isAllied2() ? ProjectileID::AlliedBullet : ProjectileID::EnemyBullet;
 
-	switch (mSpreadLevel)
+	switch (getSpreadLevel())
 	{
 	case 1:
 		createProjectile(node, type, 0.0f, 0.5f, textures);
@@ -339,7 +397,9 @@ void Aircraft::createBullets(SceneNode& node, const TextureHolder& textures) con
 
 void Aircraft::createProjectile(SceneNode& node, ProjectileID type, float xOffset, float yOffset, const TextureHolder& textures) const
 {
-	std::unique_ptr<Projectile> projectile(new Projectile(type, textures));
+	// Projectiles and pickups go into the same entity table as the aircraft that creates them
+	assert(getEntityTable());
+	std::unique_ptr<Projectile> projectile = getEntityTable()->create<Projectile>(type, textures);
 
 	sf::Vector2f offset(xOffset * mSprite.getGlobalBounds().width, yOffset * mSprite.getGlobalBounds().height);
 	sf::Vector2f velocity(0, projectile->getMaxSpeed());
@@ -354,7 +414,8 @@ void Aircraft::createPickup(SceneNode& node, const TextureHolder& textures) cons
 {
 	auto type = static_cast<PickupID>(randomInt(static_cast<int>(PickupID::TypeCount)));
 
-	std::unique_ptr<Pickup> pickup(new Pickup(type, textures));
+	assert(getEntityTable());
+	std::unique_ptr<Pickup> pickup = getEntityTable()->create<Pickup>(type, textures);
 	pickup->setPosition(getWorldPosition());
 	pickup->setVelocity(0.f, 1.f);
 	node.attachChild(std::move(pickup));
@@ -362,16 +423,21 @@ void Aircraft::createPickup(SceneNode& node, const TextureHolder& textures) cons
 
 void Aircraft::updateTexts()
 {
-	mHealthDisplay->setString(toString(getHitpoints()) + " HP");
+	// Only rebuild the strings (and the text geometry) when the values changed
+	if (getHitpoints() != mDisplayedHitpoints)
+	{
+		mDisplayedHitpoints = getHitpoints();
+		mHealthDisplay->setString(toString(mDisplayedHitpoints) + " HP");
+	}
 	mHealthDisplay->setPosition(0.f, 50.f);
-	mHealthDisplay->setRotation(-getRotation());
 
-	if (mMissileDisplay)
+	if (mPlayerState && mPlayerState->missileAmmo != mPlayerState->displayedMissileAmmo)
 	{
-		if (mMissileAmmo == 0)
-			mMissileDisplay->setString("");
+		mPlayerState->displayedMissileAmmo = mPlayerState->missileAmmo;
+		if (mPlayerState->missileAmmo == 0)
+			mPlayerState->missileDisplay->setString("");
 		else
-			mMissileDisplay->setString("M: " + toString(mMissileAmmo));
+			mPlayerState->missileDisplay->setString("M: " + toString(mPlayerState->missileAmmo));
 	}
 }
 
@@ -392,3 +458,13 @@ void Aircraft::updateRollAnimation()
 		mSprite.setTextureRect(textureRect);
 	}
 }
+
+int Aircraft::getFireRateLevel() const
+{
+	return mPlayerState ? mPlayerState->fireRateLevel : 1;
+}
+
+int Aircraft::getSpreadLevel() const
+{
+	return mPlayerState ? mPlayerState->spreadLevel : 1;
+}
@@ -6,18 +6,29 @@
 #include "TextNode.hpp"
 #include "Projectile.hpp"
 #include "Animation.hpp"
+#include "PlayerInput.hpp"
+#include "PoolAllocated.hpp"
 
-class Aircraft : public Entity
+#include <memory>
+
+struct SteeringBatch;
+
+// The state every aircraft needs each tick is kept inline. What only players use, and what only matters
+// once the aircraft is destroyed, lives in separate records, so that a horde of zombies stays small.
+class Aircraft : public Entity, public PoolAllocated<Aircraft, 16>
 {
 public:
 	Aircraft(PersonID type, const TextureHolder& textures, const FontHolder& fonts);
 	virtual unsigned int getCategory() const;
 	virtual sf::FloatRect getBoundingRect() const;
+	virtual const CollisionShape* getCollisionShape() const;
+	virtual const sf::Sprite* getCollisionSprite() const;
 	virtual bool isMarkedForRemoval() const;
 
 	float getMaxSpeed() const;
 	void fire();
 	void launchMissile();
+	void applyInput(const PlayerInput& input);
 	bool isAllied() const;
 	bool isAllied2() const;
 	void increaseFireRate();
@@ -26,12 +37,23 @@ public:
 	bool isGuided() const;
 	void guideTowards(sf::Vector2f position);
 
+	// Enemy steering, gathered for all enemies after their update and written to the table in one pass before they move
+	void pushSteering(SteeringBatch& batch, sf::Time dt);
+
+	// The unit vector the aircraft faces, straight up unless turned
+	void setHeading(sf::Vector2f heading);
+	void faceVelocity();
+
 	void playerLocalSound(CommandQueue& command, SoundEffectID effect);
 
+	static std::size_t getPlayerStateSize();
+	static std::size_t getDeathStateSize();
+	static ObjectPool& getDeathStatePool();
+
 private:
 	virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
 	virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
-	void updateMovementPattern(sf::Time dt);
+	virtual sf::Transform getLocalTransform() const;
 	void updateTexts();
 
 	void checkProjectileLaunch(sf::Time dt, CommandQueue& commands);
@@ -42,31 +64,45 @@ private:
 	void createPickup(SceneNode& node, const TextureHolder& textures) const;
 	void checkPickupDrop(CommandQueue& commands);
 	void updateRollAnimation();
+	int getFireRateLevel() const;
+	int getSpreadLevel() const;
 
 private:
-	PersonID mType;
-	sf::Sprite mSprite;
-	Animation mBloodSplat;
-	TextNode* mHealthDisplay;
-	TextNode* mMissileDisplay;
+	// Weapons and missile counter of the two players, enemies fire at the base rate
+	struct PlayerState
+	{
+		PlayerState();
 
-	bool mIsFiring;
-	bool mIsLaunchingMissile;
-	int	mFireRateLevel;
-	sf::Time mFireCountdown;
+		TextNode* missileDisplay;
+		int missileAmmo;
+		int displayedMissileAmmo;
+		int fireRateLevel;
+		int spreadLevel;
+		bool isLaunchingMissile;
+	};
 
-	bool mIsMarkedForRemoval;
+	// Created when the aircraft is destroyed, and pooled since every enemy ends up with one
+	struct DeathState : public PoolAllocated<DeathState, 16>
+	{
+		explicit DeathState(const TextureHolder& textures);
 
-	Command mFireCommand;
-	Command	mMissileCommand;
-	Command mDropPickupCommand;
-	bool mShowBloodSplat;
-	bool mPlayedBloodSplatSound;
-	bool mSpawnedPickup;
-	int mSpreadLevel;
+		Animation bloodSplat;
+		bool playedSound;
+		bool spawnedPickup;
+	};
 
-	int mMissileAmmo;
-	float mTravelledDistance;
-	std::size_t mDirectionIndex;
+private:
+	const TextureHolder& mTextures;
+	sf::Sprite mSprite;
+	TextNode* mHealthDisplay;
+	std::unique_ptr<PlayerState> mPlayerState;
+	std::unique_ptr<DeathState> mDeathState;
+	sf::Time mFireCountdown;
+	sf::Vector2f mHeading;
 	sf::Vector2f mTargetDirection;
+	std::size_t mDirectionIndex;
+	float mTravelledDistance;
+	int mDisplayedHitpoints;
+	PersonID mType;
+	bool mIsFiring;
 };
\ No newline at end of file
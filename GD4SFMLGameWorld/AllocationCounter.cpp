@@ -0,0 +1,52 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	thread_local std::size_t AllocationCount = 0;
+}
+
+std::size_t getThreadAllocationCount()
+{
+	return AllocationCount;
+}
+
+// Every form of new/delete that takes its memory from these is replaced, so that no block
+// allocated here is ever released by a library default (nothrow forms forward to these by default)
+void* operator new(std::size_t size)
+{
+	++AllocationCount;
+
+	void* memory = std::malloc(size != 0 ? size : 1);
+	if (!memory)
+		throw std::bad_alloc();
+
+	return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstddef>
+
+// Number of heap allocations made so far by the calling thread.
+// The global operator new is replaced to count them, so that hot paths can check they stay off the heap.
+std::size_t getThreadAllocationCount();
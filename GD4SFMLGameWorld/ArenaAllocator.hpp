@@ -0,0 +1,78 @@
+#pragma once
+#include "FrameArena.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// STL allocator that takes its memory from a FrameArena. Containers using it must not outlive the frame,
+// the arena is reset at the start of every World::update.
+template <typename T>
+class ArenaAllocator
+{
+public:
+	typedef T value_type;
+
+public:
+	explicit ArenaAllocator(FrameArena& arena);
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other);
+
+	T* allocate(std::size_t count);
+	void deallocate(T* memory, std::size_t count);
+
+	FrameArena& getArena() const;
+
+private:
+	FrameArena* mArena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs);
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs);
+
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator(FrameArena& arena)
+	: mArena(&arena)
+{
+}
+
+template <typename T>
+template <typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U>& other)
+	: mArena(&other.getArena())
+{
+}
+
+template <typename T>
+T* ArenaAllocator<T>::allocate(std::size_t count)
+{
+	return static_cast<T*>(mArena->allocate(count * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void ArenaAllocator<T>::deallocate(T* memory, std::size_t count)
+{
+	mArena->deallocate(memory, count * sizeof(T));
+}
+
+template <typename T>
+FrameArena& ArenaAllocator<T>::getArena() const
+{
+	return *mArena;
+}
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+	return &lhs.getArena() == &rhs.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+	return !(lhs == rhs);
+}
@@ -0,0 +1,243 @@
+#include "Broadphase.hpp"
+#include "CollisionShape.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+Broadphase::Broadphase(const CollisionMatrix& matrix)
+	: mMatrix(matrix)
+	, mColliders()
+	, mBoxes()
+	, mOverlaps()
+	, mMasks(nullptr)
+	, mNodes()
+	, mIndexPairs()
+	, mPairCache()
+	, mCurrentPairs()
+	, mColliderSerials()
+	, mContacts()
+{
+}
+
+Broadphase::~Broadphase()
+{
+}
+
+void Broadphase::setCollisionMasks(const CollisionMaskSet* masks)
+{
+	mMasks = masks;
+}
+
+void Broadphase::update(SceneNode& sceneGraph)
+{
+	mNodes.clear();
+	mColliders.clear();
+	mBoxes.clear();
+	sceneGraph.collectCollidables(mNodes);
+
+	// Skip categories without any collision rule, and nodes with an empty rect (texts, emitters...)
+	for (SceneNode* node : mNodes)
+	{
+		unsigned int category = node->getCategory();
+		if (!mMatrix.isCollidable(category))
+			continue;
+
+		sf::FloatRect rect = node->getBoundingRect();
+		if (!(rect.left < rect.left + rect.width && rect.top < rect.top + rect.height))
+			continue;
+
+		// Grow the box back to where the node started the last update
+		sf::Vector2f movement = node->getLastMovement();
+		sf::FloatRect bounds = rect;
+		bounds.left -= std::max(movement.x, 0.f);
+		bounds.top -= std::max(movement.y, 0.f);
+		bounds.width += std::abs(movement.x);
+		bounds.height += std::abs(movement.y);
+
+		mColliders.push_back({ node, bounds, rect, movement, category });
+		mBoxes.push(bounds);
+	}
+
+	rebuild();
+}
+
+void Broadphase::checkCollisions(std::vector<SceneNode::Pair>& collisionPairs)
+{
+	mIndexPairs.clear();
+	findPairs(mIndexPairs);
+
+	// Overlapping boxes are only candidates, keep the pairs whose shapes or paths really meet
+	mIndexPairs.erase(std::remove_if(mIndexPairs.begin(), mIndexPairs.end(), [this](const IndexPair& indices)
+	{
+		return !touches(mColliders[indices.first], mColliders[indices.second]);
+	}), mIndexPairs.end());
+	updateContacts();
+
+	// Colliders are numbered in scene graph order, which makes the result independent of the broadphase and pointer values
+	std::sort(mIndexPairs.begin(), mIndexPairs.end());
+	for (const IndexPair& indices : mIndexPairs)
+		collisionPairs.push_back(SceneNode::Pair(mColliders[indices.first].node, mColliders[indices.second].node));
+}
+
+const std::vector<Broadphase::Contact>& Broadphase::getContacts() const
+{
+	return mContacts;
+}
+
+void Broadphase::rebuild()
+{
+	// Nothing to prepare for the brute force test
+}
+
+void Broadphase::findPairs(std::vector<IndexPair>& indexPairs)
+{
+	for (std::size_t i = 0; i < mColliders.size(); ++i)
+	{
+		// Test against all later boxes in one batch, then drop groups without a rule between them
+		mOverlaps.clear();
+		mBoxes.findOverlaps(i, i + 1, mColliders.size(), mOverlaps);
+
+		for (std::size_t j : mOverlaps)
+		{
+			if (mMatrix.interacts(mColliders[i].category, mColliders[j].category))
+				indexPairs.push_back(IndexPair(i, j));
+		}
+	}
+}
+
+bool Broadphase::touches(const Collider& lhs, const Collider& rhs) const
+{
+	// Where both ended up, the exact shapes decide, and then the pixels within the overlap
+	if (lhs.rect.intersects(rhs.rect))
+		return shapesIntersect(lhs, rhs) && pixelsIntersect(lhs, rhs);
+
+	// Otherwise only a fast mover can have passed through the other node during the tick
+	if (lhs.movement == sf::Vector2f() && rhs.movement == sf::Vector2f())
+		return false;
+
+	return sweptIntersects(lhs, rhs);
+}
+
+bool Broadphase::shapesIntersect(const Collider& lhs, const Collider& rhs) const
+{
+	const CollisionShape* lhsShape = lhs.node->getCollisionShape();
+	const CollisionShape* rhsShape = rhs.node->getCollisionShape();
+	if (!lhsShape && !rhsShape)
+		return true;
+
+	OrientedShape lhsOriented = lhsShape ? orientShape(*lhsShape, lhs.node->getWorldTransform()) : orientShape(lhs.rect);
+	OrientedShape rhsOriented = rhsShape ? orientShape(*rhsShape, rhs.node->getWorldTransform()) : orientShape(rhs.rect);
+	return intersects(lhsOriented, rhsOriented);
+}
+
+bool Broadphase::pixelsIntersect(const Collider& lhs, const Collider& rhs) const
+{
+	const sf::Sprite* lhsSprite = lhs.node->getCollisionSprite();
+	const sf::Sprite* rhsSprite = rhs.node->getCollisionSprite();
+	if (!mMasks || !lhsSprite || !rhsSprite)
+		return true;
+
+	return mMasks->intersects(*lhsSprite, lhs.node->getWorldTransform(), *rhsSprite, rhs.node->getWorldTransform());
+}
+
+bool Broadphase::sweptIntersects(const Collider& lhs, const Collider& rhs) const
+{
+	// Move lhs relative to rhs and shrink it to its centre, growing rhs by the same half extents.
+	// The path then runs from start to start + movement, and it hits if it is inside rhs on both axes at once.
+	sf::Vector2f movement = lhs.movement - rhs.movement;
+	sf::Vector2f start(lhs.rect.left + lhs.rect.width / 2.f - movement.x, lhs.rect.top + lhs.rect.height / 2.f - movement.y);
+	sf::Vector2f lower(rhs.rect.left - lhs.rect.width / 2.f, rhs.rect.top - lhs.rect.height / 2.f);
+	sf::Vector2f upper(rhs.rect.left + rhs.rect.width + lhs.rect.width / 2.f, rhs.rect.top + rhs.rect.height + lhs.rect.height / 2.f);
+
+	float enterTime = 0.f;
+	float exitTime = 1.f;
+	const float starts[] = { start.x, start.y };
+	const float deltas[] = { movement.x, movement.y };
+	const float lowers[] = { lower.x, lower.y };
+	const float uppers[] = { upper.x, upper.y };
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		if (deltas[axis] == 0.f)
+		{
+			if (starts[axis] <= lowers[axis] || starts[axis] >= uppers[axis])
+				return false;
+
+			continue;
+		}
+
+		float axisEnter = (lowers[axis] - starts[axis]) / deltas[axis];
+		float axisExit = (uppers[axis] - starts[axis]) / deltas[axis];
+		if (axisEnter > axisExit)
+			std::swap(axisEnter, axisExit);
+
+		enterTime = std::max(enterTime, axisEnter);
+		exitTime = std::min(exitTime, axisExit);
+	}
+
+	// Touching without overlapping is no hit, same as sf::FloatRect::intersects
+	return enterTime < exitTime;
+}
+
+void Broadphase::updateContacts()
+{
+	mCurrentPairs.clear();
+	for (const IndexPair& indices : mIndexPairs)
+	{
+		SceneNode* first = mColliders[indices.first].node;
+		SceneNode* second = mColliders[indices.second].node;
+		if (first->getSerial() < second->getSerial())
+			mCurrentPairs.push_back({ std::make_pair(first->getSerial(), second->getSerial()), SceneNode::Pair(first, second) });
+		else
+			mCurrentPairs.push_back({ std::make_pair(second->getSerial(), first->getSerial()), SceneNode::Pair(second, first) });
+	}
+	std::sort(mCurrentPairs.begin(), mCurrentPairs.end(), [](const TouchingPair& lhs, const TouchingPair& rhs)
+	{
+		return lhs.serials < rhs.serials;
+	});
+
+	// Merge against last tick's pairs: only new is Enter, in both is Stay, only old is Exit
+	mContacts.clear();
+	mColliderSerials.clear();
+	auto current = mCurrentPairs.begin();
+	auto cached = mPairCache.begin();
+	while (current != mCurrentPairs.end() || cached != mPairCache.end())
+	{
+		if (cached == mPairCache.end() || (current != mCurrentPairs.end() && current->serials < cached->serials))
+		{
+			mContacts.push_back({ ContactID::Enter, current->nodes });
+			++current;
+		}
+		else if (current == mCurrentPairs.end() || cached->serials < current->serials)
+		{
+			// The cached nodes may be gone, only the ones still colliding can be handed out
+			mContacts.push_back({ ContactID::Exit, SceneNode::Pair(findNode(cached->serials.first), findNode(cached->serials.second)) });
+			++cached;
+		}
+		else
+		{
+			mContacts.push_back({ ContactID::Stay, current->nodes });
+			++current;
+			++cached;
+		}
+	}
+
+	mPairCache.swap(mCurrentPairs);
+}
+
+SceneNode* Broadphase::findNode(unsigned int serial)
+{
+	// Only needed for Exit contacts, so the sorted table is built by the first lookup of the tick
+	if (mColliderSerials.empty())
+	{
+		for (std::size_t i = 0; i < mColliders.size(); ++i)
+			mColliderSerials.push_back(std::make_pair(mColliders[i].node->getSerial(), i));
+		std::sort(mColliderSerials.begin(), mColliderSerials.end());
+	}
+
+	auto found = std::lower_bound(mColliderSerials.begin(), mColliderSerials.end(), std::make_pair(serial, std::size_t(0)));
+	if (found == mColliderSerials.end() || found->first != serial)
+		return nullptr;
+
+	return mColliders[found->second].node;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "SceneNode.hpp"
+#include "CollisionMatrix.hpp"
+#include "AabbBatch.hpp"
+#include "CollisionMaskSet.hpp"
+#include "ContactID.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <vector>
+#include <utility>
+#include <memory>
+
+// Collects the collidable nodes of the scene each tick and reports the overlapping pairs.
+// The base class tests every interacting pair (brute force), derived classes only test nearby candidates.
+// Candidates are then narrowed down with the nodes' exact collision shapes and sprite pixels,
+// or for fast movers that ended up apart, along the path they took during the last update.
+// The touching pairs are kept between ticks to report when contacts begin, persist and end.
+class Broadphase
+{
+public:
+	typedef std::unique_ptr<Broadphase> Ptr;
+	typedef std::pair<std::size_t, std::size_t> IndexPair;
+
+	struct Contact
+	{
+		ContactID type;
+		SceneNode::Pair pair;	// Nodes that stopped colliding altogether (destroyed, removed) are null in Exit contacts
+	};
+
+public:
+	explicit Broadphase(const CollisionMatrix& matrix);
+	virtual ~Broadphase();
+
+	void setCollisionMasks(const CollisionMaskSet* masks);
+	void update(SceneNode& sceneGraph);
+	void checkCollisions(std::vector<SceneNode::Pair>& collisionPairs);
+
+	// Compared to the last call of checkCollisions(), ordered by the nodes' serials
+	const std::vector<Contact>& getContacts() const;
+
+protected:
+	struct Collider
+	{
+		SceneNode* node;
+		sf::FloatRect bounds;	// Covers the whole movement of the last update
+		sf::FloatRect rect;
+		sf::Vector2f movement;
+		unsigned int category;
+	};
+
+	virtual void rebuild();
+	virtual void findPairs(std::vector<IndexPair>& indexPairs);
+
+private:
+	bool touches(const Collider& lhs, const Collider& rhs) const;
+	bool shapesIntersect(const Collider& lhs, const Collider& rhs) const;
+	bool pixelsIntersect(const Collider& lhs, const Collider& rhs) const;
+	bool sweptIntersects(const Collider& lhs, const Collider& rhs) const;
+
+	void updateContacts();
+	SceneNode* findNode(unsigned int serial);
+
+protected:
+	const CollisionMatrix& mMatrix;
+	std::vector<Collider> mColliders;
+	AabbBatch mBoxes;
+	std::vector<std::size_t> mOverlaps;
+
+private:
+	const CollisionMaskSet* mMasks;
+	std::vector<SceneNode*> mNodes;
+	std::vector<IndexPair> mIndexPairs;
+
+	struct TouchingPair
+	{
+		std::pair<unsigned int, unsigned int> serials;
+		SceneNode::Pair nodes;	// Only valid during the tick the pair was found in
+	};
+
+	std::vector<TouchingPair> mPairCache;
+	std::vector<TouchingPair> mCurrentPairs;
+	std::vector<std::pair<unsigned int, std::size_t>> mColliderSerials;	// Serial and collider index, only sorted for ticks with Exit contacts
+	std::vector<Contact> mContacts;
+};
@@ -0,0 +1,8 @@
+#pragma once
+//Broadphase used to find the colliding pairs each tick
+enum class BroadphaseID
+{
+	BruteForce,
+	UniformGrid,
+	SweepAndPrune
+};
\ No newline at end of file
@@ -13,6 +13,7 @@ enum class CategoryID
 	EnemyProjectile = 1 << 6,
 	ParticleSystem = 1 << 7,
 	SoundEffect = 1 << 8,
+	ParticleEmitter = 1 << 9,
 
 	Aircraft = PlayerAircraft | Player2Aircraft | EnemyAircraft,
 	Projectile = AlliedProjectile | EnemyProjectile,
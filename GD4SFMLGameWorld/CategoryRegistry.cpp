@@ -0,0 +1,97 @@
+#include "CategoryRegistry.hpp"
+#include "SceneNode.hpp"
+#include "ParticleNode.hpp"
+
+#include <cassert>
+
+CategoryRegistry::CategoryRegistry()
+	: mNodes()
+	, mParticleSystems()
+{
+}
+
+void CategoryRegistry::add(SceneNode& node)
+{
+	unsigned int category = node.getCategory();
+	node.mRegistry = this;
+	node.mRegisteredCategory = category;
+	if (category == 0)
+		return;
+
+	// Every node belongs to a single group, a command with several bits can't reach it twice
+	assert((category & (category - 1)) == 0);
+
+	std::vector<SceneNode*>& nodes = mNodes[toIndex(category)];
+	node.mRegistrySlot = nodes.size();
+	nodes.push_back(&node);
+}
+
+void CategoryRegistry::remove(SceneNode& node)
+{
+	assert(node.mRegistry == this);
+	node.mRegistry = nullptr;
+	if (node.mRegisteredCategory == 0)
+		return;
+
+	// Swap the last node into the freed slot
+	std::vector<SceneNode*>& nodes = mNodes[toIndex(node.mRegisteredCategory)];
+	assert(nodes[node.mRegistrySlot] == &node);
+	SceneNode* moved = nodes.back();
+	nodes[node.mRegistrySlot] = moved;
+	moved->mRegistrySlot = node.mRegistrySlot;
+	nodes.pop_back();
+
+	// Emitters attached from now on must not find a particle system that left the scene
+	if (node.mRegisteredCategory == static_cast<unsigned int>(CategoryID::ParticleSystem))
+	{
+		for (ParticleNode*& system : mParticleSystems)
+		{
+			if (system == &node)
+				system = nullptr;
+		}
+	}
+}
+
+const std::vector<SceneNode*>& CategoryRegistry::getNodes(CategoryID category) const
+{
+	return mNodes[toIndex(static_cast<unsigned int>(category))];
+}
+
+void CategoryRegistry::dispatch(const Command& command, sf::Time dt) const
+{
+	for (std::size_t i = 0; i < MaxCategories; ++i)
+	{
+		if (!(command.category & (1u << i)))
+			continue;
+
+		// Nodes the command attaches on its way (fired projectiles...) are appended behind the snapshot and left alone,
+		// while no node is removed before removeWrecks
+		const std::vector<SceneNode*>& nodes = mNodes[i];
+		std::size_t count = nodes.size();
+		for (std::size_t j = 0; j < count; ++j)
+			command.action(*nodes[j], dt);
+	}
+}
+
+void CategoryRegistry::addParticleSystem(ParticleNode& system)
+{
+	mParticleSystems[static_cast<int>(system.getParticleType())] = &system;
+}
+
+ParticleNode* CategoryRegistry::getParticleSystem(ParticleID type) const
+{
+	return mParticleSystems[static_cast<int>(type)];
+}
+
+std::size_t CategoryRegistry::toIndex(unsigned int category)
+{
+	assert(category != 0);
+
+	std::size_t index = 0;
+	while (!(category & 1u))
+	{
+		category >>= 1;
+		++index;
+	}
+	return index;
+}
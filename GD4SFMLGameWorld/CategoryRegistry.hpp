@@ -0,0 +1,77 @@
+#pragma once
+#include "Command.hpp"
+#include "ParticleID.hpp"
+#include "CategoryTraits.hpp"
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <array>
+#include <vector>
+#include <cassert>
+
+class SceneNode;
+class ParticleNode;
+
+// Lists the live nodes of a scene graph by category bit, so that a command only visits the nodes it is meant for.
+// Nodes register when their subtree is attached below the registered root and unregister when detached or destroyed.
+// Nodes are visited category by category, lowest bit first, and within a category in registration order,
+// except that a removed node's slot is taken over by the last node of its category. This is not the scene graph's
+// depth-first order, so a command matching several nodes (projectiles, sounds...) may reach them in a different order
+// than SceneNode::onCommand would. Responses must not depend on that order.
+class CategoryRegistry : private sf::NonCopyable
+{
+public:
+	static const std::size_t MaxCategories = 32;
+
+public:
+	CategoryRegistry();
+
+	void add(SceneNode& node);
+	void remove(SceneNode& node);
+
+	const std::vector<SceneNode*>& getNodes(CategoryID category) const;
+	void dispatch(const Command& command, sf::Time dt) const;
+
+	// The particle system of each type, which emitters bind to as they get attached
+	void addParticleSystem(ParticleNode& system);
+	ParticleNode* getParticleSystem(ParticleID type) const;
+
+	// Calls fn directly on every GameObject node, or only those in the given subset of its categories
+	template <typename GameObject, typename Function>
+	void forEach(Function fn) const;
+	template <typename GameObject, typename Function>
+	void forEach(unsigned int categories, Function fn) const;
+
+private:
+	static std::size_t toIndex(unsigned int category);
+
+private:
+	std::array<std::vector<SceneNode*>, MaxCategories> mNodes;
+	std::array<ParticleNode*, static_cast<int>(ParticleID::ParticleCount)> mParticleSystems;
+};
+
+template <typename GameObject, typename Function>
+void CategoryRegistry::forEach(Function fn) const
+{
+	forEach<GameObject>(CategoryTraits<GameObject>::Categories, fn);
+}
+
+template <typename GameObject, typename Function>
+void CategoryRegistry::forEach(unsigned int categories, Function fn) const
+{
+	assert((categories & ~CategoryTraits<GameObject>::Categories) == 0);
+
+	for (std::size_t i = 0; i < MaxCategories; ++i)
+	{
+		if (!(categories & (1u << i)))
+			continue;
+
+		// Same snapshot as dispatch(), nodes attached by fn are left for the next call
+		const std::vector<SceneNode*>& nodes = mNodes[i];
+		std::size_t count = nodes.size();
+		for (std::size_t j = 0; j < count; ++j)
+			fn(static_cast<GameObject&>(*nodes[j]));
+	}
+}
+
@@ -0,0 +1,66 @@
+#pragma once
+#include "CategoryID.hpp"
+
+class SceneNode;
+class Entity;
+class Aircraft;
+class Projectile;
+class Pickup;
+class SoundNode;
+class ParticleNode;
+class EmitterNode;
+
+// Binds each command target type to the categories its nodes report through getCategory().
+// Every node in one of these categories is of that type, so commands and systems can pick the
+// nodes by category and downcast them without RTTI. Types not listed here can't be targeted.
+template <typename GameObject>
+struct CategoryTraits;
+
+template <>
+struct CategoryTraits<SceneNode>
+{
+	static const unsigned int Categories = ~0u;
+};
+
+template <>
+struct CategoryTraits<Entity>
+{
+	static const unsigned int Categories = static_cast<unsigned int>(CategoryID::Aircraft)
+		| static_cast<unsigned int>(CategoryID::Projectile) | static_cast<unsigned int>(CategoryID::Pickup);
+};
+
+template <>
+struct CategoryTraits<Aircraft>
+{
+	static const unsigned int Categories = static_cast<unsigned int>(CategoryID::Aircraft);
+};
+
+template <>
+struct CategoryTraits<Projectile>
+{
+	static const unsigned int Categories = static_cast<unsigned int>(CategoryID::Projectile);
+};
+
+template <>
+struct CategoryTraits<Pickup>
+{
+	static const unsigned int Categories = static_cast<unsigned int>(CategoryID::Pickup);
+};
+
+template <>
+struct CategoryTraits<SoundNode>
+{
+	static const unsigned int Categories = static_cast<unsigned int>(CategoryID::SoundEffect);
+};
+
+template <>
+struct CategoryTraits<ParticleNode>
+{
+	static const unsigned int Categories = static_cast<unsigned int>(CategoryID::ParticleSystem);
+};
+
+template <>
+struct CategoryTraits<EmitterNode>
+{
+	static const unsigned int Categories = static_cast<unsigned int>(CategoryID::ParticleEmitter);
+};
@@ -0,0 +1,83 @@
+#include "CollisionBenchmark.hpp"
+#include "AabbBatch.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+	typedef std::chrono::high_resolution_clock Clock;
+
+	// Entities of the game's size spread over an area that grows with their count, so the overlap rate stays realistic
+	std::vector<sf::FloatRect> createRects(std::size_t count)
+	{
+		std::mt19937 generator(static_cast<unsigned int>(count));
+		float extent = 64.f * std::sqrt(static_cast<float>(count));
+		std::uniform_real_distribution<float> position(0.f, extent);
+		std::uniform_real_distribution<float> size(8.f, 64.f);
+
+		std::vector<sf::FloatRect> rects;
+		for (std::size_t i = 0; i < count; ++i)
+			rects.push_back(sf::FloatRect(position(generator), position(generator), size(generator), size(generator)));
+
+		return rects;
+	}
+
+	double toNanoseconds(Clock::duration duration, std::size_t tests)
+	{
+		return std::chrono::duration<double, std::nano>(duration).count() / tests;
+	}
+}
+
+void runCollisionBenchmark(std::ostream& out)
+{
+	out << "AABB kernel: " << AabbBatch::getKernelName() << "\n";
+
+	const std::size_t counts[] = { 100, 1000, 10000 };
+	for (std::size_t count : counts)
+	{
+		std::vector<sf::FloatRect> rects = createRects(count);
+		AabbBatch batch;
+		for (const sf::FloatRect& rect : rects)
+			batch.push(rect);
+
+		// Every pair is tested, repeated until each path runs about 50 million tests
+		std::size_t pairs = count * (count - 1) / 2;
+		std::size_t repeats = std::max<std::size_t>(1, 50000000 / pairs);
+
+		std::size_t rectHits = 0;
+		Clock::time_point start = Clock::now();
+		for (std::size_t repeat = 0; repeat < repeats; ++repeat)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				for (std::size_t j = i + 1; j < count; ++j)
+					rectHits += rects[i].intersects(rects[j]) ? 1 : 0;
+		}
+		Clock::duration rectTime = Clock::now() - start;
+
+		std::size_t batchHits = 0;
+		std::vector<std::size_t> overlaps;
+		start = Clock::now();
+		for (std::size_t repeat = 0; repeat < repeats; ++repeat)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				overlaps.clear();
+				batch.findOverlaps(i, i + 1, count, overlaps);
+				batchHits += overlaps.size();
+			}
+		}
+		Clock::duration batchTime = Clock::now() - start;
+
+		double rectNs = toNanoseconds(rectTime, pairs * repeats);
+		double batchNs = toNanoseconds(batchTime, pairs * repeats);
+		out << count << " entities: FloatRect " << rectNs << " ns/pair, batch " << batchNs << " ns/pair, speedup "
+			<< rectNs / batchNs << "x" << (rectHits == batchHits ? "" : " (RESULTS DIFFER)") << "\n";
+	}
+}
@@ -0,0 +1,6 @@
+#pragma once
+#include <ostream>
+
+// Times the packed AABB kernel against testing sf::FloatRect pairs one by one.
+// Build with COLLISION_BENCHMARK defined to run it from main instead of the game.
+void runCollisionBenchmark(std::ostream& out);
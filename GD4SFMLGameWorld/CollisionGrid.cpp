@@ -0,0 +1,169 @@
+#include "CollisionGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+	// Below this the threads cost more to wake up than they save
+	const std::size_t MinParallelColliders = 256;
+	const std::size_t TasksPerWorker = 4;
+}
+
+CollisionGrid::CollisionGrid(const CollisionMatrix& matrix, WorkerPool* workers, float cellSize)
+	: Broadphase(matrix)
+	, mWorkers(workers)
+	, mWorkerResults()
+	, mCellSize(cellSize)
+	, mEffectiveCellSize(cellSize)
+	, mOrigin()
+	, mColumns(0)
+	, mRows(0)
+	, mCellStart()
+	, mCellEntries()
+	, mCellFill()
+	, mCellBoxes()
+{
+}
+
+void CollisionGrid::rebuild()
+{
+	mColumns = 0;
+	mRows = 0;
+	if (mColliders.empty())
+		return;
+
+	// Span the grid over the area actually covered by colliders
+	float left = mColliders.front().bounds.left;
+	float top = mColliders.front().bounds.top;
+	float right = left;
+	float bottom = top;
+	for (const Collider& collider : mColliders)
+	{
+		left = std::min(left, collider.bounds.left);
+		top = std::min(top, collider.bounds.top);
+		right = std::max(right, collider.bounds.left + collider.bounds.width);
+		bottom = std::max(bottom, collider.bounds.top + collider.bounds.height);
+	}
+
+	// Coarsen the cells if a few far-away colliders would blow up the grid
+	const float maxCells = 4.f * mColliders.size() + 64.f;
+	mEffectiveCellSize = mCellSize;
+	float cells = std::ceil((right - left) / mEffectiveCellSize + 1.f) * std::ceil((bottom - top) / mEffectiveCellSize + 1.f);
+	if (cells > maxCells)
+		mEffectiveCellSize *= std::sqrt(cells / maxCells) + 1.f;
+
+	mOrigin = sf::Vector2f(left, top);
+	mColumns = getColumn(right) + 1;
+	mRows = getRow(bottom) + 1;
+
+	// Counting sort of the colliders into the cells they overlap
+	mCellStart.assign(mColumns * mRows + 1, 0);
+	for (const Collider& collider : mColliders)
+	{
+		std::size_t lastColumn = getColumn(collider.bounds.left + collider.bounds.width);
+		std::size_t lastRow = getRow(collider.bounds.top + collider.bounds.height);
+		for (std::size_t row = getRow(collider.bounds.top); row <= lastRow; ++row)
+			for (std::size_t column = getColumn(collider.bounds.left); column <= lastColumn; ++column)
+				++mCellStart[row * mColumns + column + 1];
+	}
+
+	for (std::size_t cell = 1; cell < mCellStart.size(); ++cell)
+		mCellStart[cell] += mCellStart[cell - 1];
+
+	mCellEntries.resize(mCellStart.back());
+	mCellBoxes.resize(mCellStart.back());
+	mCellFill.assign(mCellStart.begin(), mCellStart.end() - 1);
+	for (std::size_t i = 0; i < mColliders.size(); ++i)
+	{
+		const sf::FloatRect& bounds = mColliders[i].bounds;
+		std::size_t lastColumn = getColumn(bounds.left + bounds.width);
+		std::size_t lastRow = getRow(bounds.top + bounds.height);
+		for (std::size_t row = getRow(bounds.top); row <= lastRow; ++row)
+		{
+			for (std::size_t column = getColumn(bounds.left); column <= lastColumn; ++column)
+			{
+				std::size_t entry = mCellFill[row * mColumns + column]++;
+				mCellEntries[entry] = i;
+				mCellBoxes.set(entry, bounds);
+			}
+		}
+	}
+}
+
+void CollisionGrid::findPairs(std::vector<IndexPair>& indexPairs)
+{
+	std::size_t cells = mColumns * mRows;
+	std::size_t workers = mWorkers ? mWorkers->getWorkerCount() : 1;
+	if (workers == 1 || mColliders.size() < MinParallelColliders || cells < 2)
+	{
+		findPairsInCells(0, cells, indexPairs, mOverlaps);
+		return;
+	}
+
+	// Each worker collects into its own buffers, the grid and colliders are only read
+	mWorkerResults.resize(workers);
+	for (WorkerResult& result : mWorkerResults)
+		result.indexPairs.clear();
+
+	std::size_t tasks = std::min(cells, TasksPerWorker * workers);
+	mWorkers->run(tasks, [this, cells, tasks](std::size_t task, std::size_t worker)
+	{
+		WorkerResult& result = mWorkerResults[worker];
+		findPairsInCells(task * cells / tasks, (task + 1) * cells / tasks, result.indexPairs, result.overlaps);
+	});
+
+	// Which worker got which cells changes from run to run, checkCollisions sorts the merged pairs into scene order
+	for (const WorkerResult& result : mWorkerResults)
+		indexPairs.insert(indexPairs.end(), result.indexPairs.begin(), result.indexPairs.end());
+}
+
+void CollisionGrid::findPairsInCells(std::size_t firstCell, std::size_t lastCell, std::vector<IndexPair>& indexPairs, std::vector<std::size_t>& overlaps) const
+{
+	for (std::size_t cell = firstCell; cell < lastCell; ++cell)
+	{
+		std::size_t row = cell / mColumns;
+		std::size_t column = cell % mColumns;
+		std::size_t begin = mCellStart[cell];
+		std::size_t end = mCellStart[cell + 1];
+
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			std::size_t lhsIndex = mCellEntries[i];
+			const Collider& lhs = mColliders[lhsIndex];
+
+			// The boxes of a cell are packed next to each other, so the rest of the cell is tested in one batch
+			overlaps.clear();
+			mCellBoxes.findOverlaps(i, i + 1, end, overlaps);
+
+			for (std::size_t j : overlaps)
+			{
+				std::size_t rhsIndex = mCellEntries[j];
+				const Collider& rhs = mColliders[rhsIndex];
+
+				// Groups without a rule between them are never tested
+				if (!mMatrix.interacts(lhs.category, rhs.category))
+					continue;
+
+				// A pair sharing several cells is only reported in the cell holding the top-left corner of their overlap,
+				// so every pair is found exactly once
+				if (getColumn(std::max(lhs.bounds.left, rhs.bounds.left)) == column
+					&& getRow(std::max(lhs.bounds.top, rhs.bounds.top)) == row)
+					indexPairs.push_back(std::minmax(lhsIndex, rhsIndex));
+			}
+		}
+	}
+}
+
+std::size_t CollisionGrid::getColumn(float x) const
+{
+	std::size_t column = static_cast<std::size_t>(std::max(0.f, (x - mOrigin.x) / mEffectiveCellSize));
+	return (mColumns == 0) ? column : std::min(column, mColumns - 1);
+}
+
+std::size_t CollisionGrid::getRow(float y) const
+{
+	std::size_t row = static_cast<std::size_t>(std::max(0.f, (y - mOrigin.y) / mEffectiveCellSize));
+	return (mRows == 0) ? row : std::min(row, mRows - 1);
+}
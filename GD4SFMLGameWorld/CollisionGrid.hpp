@@ -0,0 +1,43 @@
+#pragma once
+#include "Broadphase.hpp"
+#include "WorkerPool.hpp"
+
+#include <vector>
+
+// Uniform grid broadphase: buckets every collidable node by its bounding rect,
+// so that only nodes sharing a cell are tested against each other.
+// With a worker pool and enough colliders, the cells are shared out between the workers.
+class CollisionGrid : public Broadphase
+{
+public:
+	explicit CollisionGrid(const CollisionMatrix& matrix, WorkerPool* workers = nullptr, float cellSize = 128.f);
+
+private:
+	virtual void rebuild();
+	virtual void findPairs(std::vector<IndexPair>& indexPairs);
+	void findPairsInCells(std::size_t firstCell, std::size_t lastCell, std::vector<IndexPair>& indexPairs, std::vector<std::size_t>& overlaps) const;
+
+	std::size_t getColumn(float x) const;
+	std::size_t getRow(float y) const;
+
+private:
+	struct WorkerResult
+	{
+		std::vector<IndexPair> indexPairs;
+		std::vector<std::size_t> overlaps;
+	};
+
+	WorkerPool* mWorkers;
+	std::vector<WorkerResult> mWorkerResults;
+
+	float mCellSize;
+	float mEffectiveCellSize;
+	sf::Vector2f mOrigin;
+	std::size_t mColumns;
+	std::size_t mRows;
+
+	std::vector<std::size_t> mCellStart;
+	std::vector<std::size_t> mCellEntries;
+	std::vector<std::size_t> mCellFill;
+	AabbBatch mCellBoxes;
+};
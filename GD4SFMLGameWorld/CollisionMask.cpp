@@ -0,0 +1,65 @@
+#include "CollisionMask.hpp"
+
+#include <cassert>
+
+
+namespace
+{
+	// Anti-aliased edges only count once they are at least half opaque
+	const sf::Uint8 AlphaThreshold = 128;
+}
+
+CollisionMask::CollisionMask(const sf::Image& image, const sf::IntRect& textureRect, bool rotated)
+	: mWidth(textureRect.width)
+	, mHeight(textureRect.height)
+	, mWordsPerRow((textureRect.width + 63) / 64)
+	, mWords(mWordsPerRow * textureRect.height, 0)
+{
+	for (int y = 0; y < mHeight; ++y)
+	{
+		for (int x = 0; x < mWidth; ++x)
+		{
+			int sourceX = textureRect.left + (rotated ? mWidth - 1 - x : x);
+			int sourceY = textureRect.top + (rotated ? mHeight - 1 - y : y);
+			if (image.getPixel(sourceX, sourceY).a >= AlphaThreshold)
+				mWords[y * mWordsPerRow + x / 64] |= std::uint64_t(1) << (x % 64);
+		}
+	}
+}
+
+int CollisionMask::getWidth() const
+{
+	return mWidth;
+}
+
+int CollisionMask::getHeight() const
+{
+	return mHeight;
+}
+
+bool CollisionMask::isSolid(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= mWidth || y >= mHeight)
+		return false;
+
+	return (mWords[y * mWordsPerRow + x / 64] >> (x % 64)) & 1u;
+}
+
+std::uint64_t CollisionMask::getBits(int x, int y, int count) const
+{
+	assert(count > 0 && count <= 64 && x >= 0 && x + count <= mWidth);
+
+	// Stitch the wanted pixels together from the one or two words they span
+	const std::uint64_t* row = &mWords[y * mWordsPerRow];
+	std::size_t word = x / 64;
+	int shift = x % 64;
+
+	std::uint64_t bits = row[word] >> shift;
+	if (shift != 0 && word + 1 < mWordsPerRow)
+		bits |= row[word + 1] << (64 - shift);
+
+	if (count < 64)
+		bits &= (std::uint64_t(1) << count) - 1;
+
+	return bits;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <vector>
+#include <cstdint>
+
+// One bit per texture pixel telling whether it is solid enough to be hit, packed 64 pixels to a word.
+// The rotated mask is the same rect turned by 180 degrees, the way enemies face down the screen.
+class CollisionMask
+{
+public:
+	CollisionMask(const sf::Image& image, const sf::IntRect& textureRect, bool rotated);
+
+	int getWidth() const;
+	int getHeight() const;
+	bool isSolid(int x, int y) const;
+
+	// Pixels x .. x + count - 1 of row y, pixel x in the lowest bit (count from 1 to 64)
+	std::uint64_t getBits(int x, int y, int count) const;
+
+private:
+	int mWidth;
+	int mHeight;
+	std::size_t mWordsPerRow;
+	std::vector<std::uint64_t> mWords;
+};
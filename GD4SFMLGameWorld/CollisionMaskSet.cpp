@@ -0,0 +1,132 @@
+#include "CollisionMaskSet.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+	const float Epsilon = 0.0001f;
+
+	bool isNear(float value, float target)
+	{
+		return std::abs(value - target) < Epsilon;
+	}
+}
+
+void CollisionMaskSet::build(const sf::Texture& texture, const sf::Image& image, const sf::IntRect& textureRect)
+{
+	Key key(&texture, textureRect.left, textureRect.top, textureRect.width, textureRect.height);
+	if (mMasks.find(key) != mMasks.end())
+		return;
+
+	Masks masks = { CollisionMask(image, textureRect, false), CollisionMask(image, textureRect, true) };
+	mMasks.insert(std::make_pair(key, masks));
+}
+
+bool CollisionMaskSet::intersects(const sf::Sprite& lhs, const sf::Transform& lhsTransform, const sf::Sprite& rhs, const sf::Transform& rhsTransform) const
+{
+	const Masks* lhsMasks = find(lhs);
+	const Masks* rhsMasks = find(rhs);
+	if (!lhsMasks || !rhsMasks)
+		return true;
+
+	// Maps the sprite's texture rect, from (0, 0) to its size, into the world
+	sf::Transform lhsToWorld = lhsTransform * lhs.getTransform();
+	sf::Transform rhsToWorld = rhsTransform * rhs.getTransform();
+
+	// Upright or upside down sprites line up with the pixel grid and are compared 64 pixels at a time
+	Placement lhsPlacement;
+	Placement rhsPlacement;
+	if (place(*lhsMasks, lhsToWorld, lhsPlacement) && place(*rhsMasks, rhsToWorld, rhsPlacement))
+		return wordsIntersect(lhsPlacement, rhsPlacement);
+
+	return pixelsIntersect(lhsMasks->upright, lhsToWorld, rhsMasks->upright, rhsToWorld);
+}
+
+const CollisionMaskSet::Masks* CollisionMaskSet::find(const sf::Sprite& sprite) const
+{
+	const sf::IntRect& textureRect = sprite.getTextureRect();
+	auto found = mMasks.find(Key(sprite.getTexture(), textureRect.left, textureRect.top, textureRect.width, textureRect.height));
+	return (found != mMasks.end()) ? &found->second : nullptr;
+}
+
+bool CollisionMaskSet::place(const Masks& masks, const sf::Transform& transform, Placement& placement) const
+{
+	const float* matrix = transform.getMatrix();
+	float x = matrix[12];
+	float y = matrix[13];
+
+	if (isNear(matrix[0], 1.f) && isNear(matrix[5], 1.f) && isNear(matrix[1], 0.f) && isNear(matrix[4], 0.f))
+	{
+		placement.mask = &masks.upright;
+	}
+	else if (isNear(matrix[0], -1.f) && isNear(matrix[5], -1.f) && isNear(matrix[1], 0.f) && isNear(matrix[4], 0.f))
+	{
+		// The texture's origin ends up at the bottom right corner
+		placement.mask = &masks.rotated;
+		x -= masks.rotated.getWidth();
+		y -= masks.rotated.getHeight();
+	}
+	else
+	{
+		return false;
+	}
+
+	// Sprites off the pixel grid are snapped to it, which is at most half a pixel off
+	placement.left = static_cast<int>(std::floor(x + 0.5f));
+	placement.top = static_cast<int>(std::floor(y + 0.5f));
+	return true;
+}
+
+bool CollisionMaskSet::wordsIntersect(const Placement& lhs, const Placement& rhs) const
+{
+	int left = std::max(lhs.left, rhs.left);
+	int top = std::max(lhs.top, rhs.top);
+	int right = std::min(lhs.left + lhs.mask->getWidth(), rhs.left + rhs.mask->getWidth());
+	int bottom = std::min(lhs.top + lhs.mask->getHeight(), rhs.top + rhs.mask->getHeight());
+
+	for (int y = top; y < bottom; ++y)
+	{
+		for (int x = left; x < right; x += 64)
+		{
+			int count = std::min(64, right - x);
+			if (lhs.mask->getBits(x - lhs.left, y - lhs.top, count) & rhs.mask->getBits(x - rhs.left, y - rhs.top, count))
+				return true;
+		}
+	}
+	return false;
+}
+
+bool CollisionMaskSet::pixelsIntersect(const CollisionMask& lhs, const sf::Transform& lhsTransform, const CollisionMask& rhs, const sf::Transform& rhsTransform) const
+{
+	// Turned sprites: sample the centre of every world pixel both sprites cover, looking it up in both masks
+	sf::FloatRect lhsBounds = lhsTransform.transformRect(sf::FloatRect(0.f, 0.f, static_cast<float>(lhs.getWidth()), static_cast<float>(lhs.getHeight())));
+	sf::FloatRect rhsBounds = rhsTransform.transformRect(sf::FloatRect(0.f, 0.f, static_cast<float>(rhs.getWidth()), static_cast<float>(rhs.getHeight())));
+	sf::FloatRect overlap;
+	if (!lhsBounds.intersects(rhsBounds, overlap))
+		return false;
+
+	sf::Transform lhsInverse = lhsTransform.getInverse();
+	sf::Transform rhsInverse = rhsTransform.getInverse();
+	int left = static_cast<int>(std::floor(overlap.left));
+	int top = static_cast<int>(std::floor(overlap.top));
+	int right = static_cast<int>(std::ceil(overlap.left + overlap.width));
+	int bottom = static_cast<int>(std::ceil(overlap.top + overlap.height));
+
+	for (int y = top; y < bottom; ++y)
+	{
+		for (int x = left; x < right; ++x)
+		{
+			sf::Vector2f centre(x + 0.5f, y + 0.5f);
+			sf::Vector2f lhsPixel = lhsInverse.transformPoint(centre);
+			if (!lhs.isSolid(static_cast<int>(std::floor(lhsPixel.x)), static_cast<int>(std::floor(lhsPixel.y))))
+				continue;
+
+			sf::Vector2f rhsPixel = rhsInverse.transformPoint(centre);
+			if (rhs.isSolid(static_cast<int>(std::floor(rhsPixel.x)), static_cast<int>(std::floor(rhsPixel.y))))
+				return true;
+		}
+	}
+	return false;
+}
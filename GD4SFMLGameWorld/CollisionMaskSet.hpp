@@ -0,0 +1,44 @@
+#pragma once
+#include "CollisionMask.hpp"
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <map>
+#include <tuple>
+
+// Collision masks for every texture rect sprites are drawn with, built once when the textures are loaded
+class CollisionMaskSet : private sf::NonCopyable
+{
+public:
+	void build(const sf::Texture& texture, const sf::Image& image, const sf::IntRect& textureRect);
+
+	// Whether any solid pixels of both sprites cover the same spot. Sprites without a mask count as solid all over.
+	bool intersects(const sf::Sprite& lhs, const sf::Transform& lhsTransform, const sf::Sprite& rhs, const sf::Transform& rhsTransform) const;
+
+private:
+	struct Masks
+	{
+		CollisionMask upright;
+		CollisionMask rotated;
+	};
+
+	struct Placement
+	{
+		const CollisionMask* mask;
+		int left;
+		int top;
+	};
+
+	typedef std::tuple<const sf::Texture*, int, int, int, int> Key;
+
+	const Masks* find(const sf::Sprite& sprite) const;
+	bool place(const Masks& masks, const sf::Transform& transform, Placement& placement) const;
+	bool wordsIntersect(const Placement& lhs, const Placement& rhs) const;
+	bool pixelsIntersect(const CollisionMask& lhs, const sf::Transform& lhsTransform, const CollisionMask& rhs, const sf::Transform& rhsTransform) const;
+
+private:
+	std::map<Key, Masks> mMasks;
+};
@@ -0,0 +1,87 @@
+#include "CollisionMatrix.hpp"
+
+
+CollisionMatrix::CollisionMatrix()
+	: mHandlers()
+	, mEntries()
+	, mInteractions()
+	, mCollidableCategories(0)
+{
+	for (auto& row : mEntries)
+		row.fill({ -1, false, false });
+}
+
+void CollisionMatrix::addHandler(unsigned int first, unsigned int second, Handler handler, bool onEnter)
+{
+	int rule = static_cast<int>(mHandlers.size());
+	mHandlers.push_back(std::move(handler));
+
+	// Expand combined masks into every single-bit cell, in both orders
+	for (std::size_t i = 0; i < MaxCategories; ++i)
+	{
+		if (!(first & (1u << i)))
+			continue;
+
+		for (std::size_t j = 0; j < MaxCategories; ++j)
+		{
+			if (!(second & (1u << j)))
+				continue;
+
+			assert(mEntries[i][j].rule == -1);
+			mEntries[i][j] = { rule, false, onEnter };
+			if (i != j)
+				mEntries[j][i] = { rule, true, onEnter };
+
+			mInteractions[i] |= 1u << j;
+			mInteractions[j] |= 1u << i;
+		}
+	}
+
+	mCollidableCategories |= first | second;
+}
+
+bool CollisionMatrix::isCollidable(unsigned int category) const
+{
+	return (category & mCollidableCategories) != 0;
+}
+
+bool CollisionMatrix::interacts(unsigned int category1, unsigned int category2) const
+{
+	return category1 != 0 && (mInteractions[toIndex(category1)] & category2) != 0;
+}
+
+void CollisionMatrix::dispatch(const SceneNode::Pair& pair) const
+{
+	run(pair, false);
+}
+
+void CollisionMatrix::dispatchEnter(const SceneNode::Pair& pair) const
+{
+	run(pair, true);
+}
+
+void CollisionMatrix::run(const SceneNode::Pair& pair, bool onEnter) const
+{
+	const Entry& entry = mEntries[toIndex(pair.first->getCategory())][toIndex(pair.second->getCategory())];
+	if (entry.rule < 0 || entry.onEnter != onEnter)
+		return;
+
+	// Hand the nodes over in the order the rule was declared with
+	if (entry.swapped)
+		mHandlers[entry.rule](*pair.second, *pair.first);
+	else
+		mHandlers[entry.rule](*pair.first, *pair.second);
+}
+
+std::size_t CollisionMatrix::toIndex(unsigned int category)
+{
+	assert(category != 0);
+
+	std::size_t index = 0;
+	while (!(category & 1u))
+	{
+		category >>= 1;
+		++index;
+	}
+	return index;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "CategoryID.hpp"
+#include "CategoryTraits.hpp"
+#include "SceneNode.hpp"
+
+#include <array>
+#include <vector>
+#include <functional>
+#include <cassert>
+
+// Declares which categories react to touching each other, and how.
+// Nodes are expected to carry a single category bit; rules may use combined masks.
+// A rule runs on every tick the nodes touch, or with addEnterRule() only on the tick they start touching.
+class CollisionMatrix
+{
+public:
+	typedef std::function<void(SceneNode&, SceneNode&)> Handler;
+
+public:
+	CollisionMatrix();
+
+	template<typename First, typename Second, typename Function>
+	void addRule(CategoryID first, CategoryID second, Function fn);
+	template<typename First, typename Second, typename Function>
+	void addEnterRule(CategoryID first, CategoryID second, Function fn);
+
+	bool isCollidable(unsigned int category) const;
+	bool interacts(unsigned int category1, unsigned int category2) const;
+	void dispatch(const SceneNode::Pair& pair) const;
+	void dispatchEnter(const SceneNode::Pair& pair) const;
+
+private:
+	template<typename First, typename Second, typename Function>
+	void addTypedRule(CategoryID first, CategoryID second, Function fn, bool onEnter);
+	void addHandler(unsigned int first, unsigned int second, Handler handler, bool onEnter);
+	void run(const SceneNode::Pair& pair, bool onEnter) const;
+	static std::size_t toIndex(unsigned int category);
+
+private:
+	static const std::size_t MaxCategories = 32;
+
+	struct Entry
+	{
+		int rule;
+		bool swapped;
+		bool onEnter;
+	};
+
+	std::vector<Handler> mHandlers;
+	std::array<std::array<Entry, MaxCategories>, MaxCategories> mEntries;
+	std::array<unsigned int, MaxCategories> mInteractions;
+	unsigned int mCollidableCategories;
+};
+
+template<typename First, typename Second, typename Function>
+void CollisionMatrix::addRule(CategoryID first, CategoryID second, Function fn)
+{
+	addTypedRule<First, Second>(first, second, fn, false);
+}
+
+template<typename First, typename Second, typename Function>
+void CollisionMatrix::addEnterRule(CategoryID first, CategoryID second, Function fn)
+{
+	addTypedRule<First, Second>(first, second, fn, true);
+}
+
+template<typename First, typename Second, typename Function>
+void CollisionMatrix::addTypedRule(CategoryID first, CategoryID second, Function fn, bool onEnter)
+{
+	//The categories decide the node types (see CategoryTraits), check once here instead of on every hit
+	assert((static_cast<unsigned int>(first) & ~CategoryTraits<First>::Categories) == 0);
+	assert((static_cast<unsigned int>(second) & ~CategoryTraits<Second>::Categories) == 0);
+
+	addHandler(static_cast<unsigned int>(first), static_cast<unsigned int>(second), [=](SceneNode& lhs, SceneNode& rhs)
+	{
+		fn(static_cast<First&>(lhs), static_cast<Second&>(rhs));
+	}, onEnter);
+}
@@ -0,0 +1,118 @@
+#include "CollisionShape.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+	float dot(sf::Vector2f lhs, sf::Vector2f rhs)
+	{
+		return lhs.x * rhs.x + lhs.y * rhs.y;
+	}
+
+	float length(sf::Vector2f vector)
+	{
+		return std::sqrt(dot(vector, vector));
+	}
+
+	// Half the length of the box projected onto a unit axis
+	float projectedRadius(const OrientedShape& box, sf::Vector2f axis)
+	{
+		return box.halfSize.x * std::abs(dot(box.axisX, axis)) + box.halfSize.y * std::abs(dot(box.axisY, axis));
+	}
+
+	bool boxesIntersect(const OrientedShape& lhs, const OrientedShape& rhs)
+	{
+		// Separating axis test, two boxes only have to be checked along their four edge directions
+		sf::Vector2f offset = rhs.centre - lhs.centre;
+		const sf::Vector2f axes[] = { lhs.axisX, lhs.axisY, rhs.axisX, rhs.axisY };
+		for (sf::Vector2f axis : axes)
+		{
+			if (std::abs(dot(offset, axis)) >= projectedRadius(lhs, axis) + projectedRadius(rhs, axis))
+				return false;
+		}
+		return true;
+	}
+
+	bool circlesIntersect(const OrientedShape& lhs, const OrientedShape& rhs)
+	{
+		sf::Vector2f offset = rhs.centre - lhs.centre;
+		float radii = lhs.halfSize.x + rhs.halfSize.x;
+		return dot(offset, offset) < radii * radii;
+	}
+
+	// centreOrigin() rounds the origin down to whole pixels, so odd sized sprites sit half a pixel off
+	sf::Vector2f spriteCentre(const sf::IntRect& textureRect)
+	{
+		float halfWidth = textureRect.width / 2.f;
+		float halfHeight = textureRect.height / 2.f;
+		return sf::Vector2f(halfWidth - std::floor(halfWidth), halfHeight - std::floor(halfHeight));
+	}
+
+	bool boxIntersectsCircle(const OrientedShape& box, const OrientedShape& circle)
+	{
+		// Clamp the circle centre into the box, in the box's own frame
+		sf::Vector2f offset = circle.centre - box.centre;
+		float x = dot(offset, box.axisX);
+		float y = dot(offset, box.axisY);
+		float dx = x - std::max(-box.halfSize.x, std::min(x, box.halfSize.x));
+		float dy = y - std::max(-box.halfSize.y, std::min(y, box.halfSize.y));
+		return dx * dx + dy * dy < circle.halfSize.x * circle.halfSize.x;
+	}
+}
+
+CollisionShape boxShape(const sf::IntRect& textureRect)
+{
+	return { ShapeID::Box, spriteCentre(textureRect), sf::Vector2f(textureRect.width / 2.f, textureRect.height / 2.f) };
+}
+
+CollisionShape circleShape(const sf::IntRect& textureRect, float radius)
+{
+	return { ShapeID::Circle, spriteCentre(textureRect), sf::Vector2f(radius, radius) };
+}
+
+OrientedShape orientShape(const CollisionShape& shape, const sf::Transform& transform)
+{
+	OrientedShape oriented;
+	oriented.type = shape.type;
+	oriented.centre = transform.transformPoint(shape.centre);
+	oriented.axisX = transform.transformPoint(shape.centre.x + 1.f, shape.centre.y) - oriented.centre;
+	oriented.axisY = transform.transformPoint(shape.centre.x, shape.centre.y + 1.f) - oriented.centre;
+
+	// Fold any scale into the extents so the axes stay unit length
+	float scaleX = length(oriented.axisX);
+	float scaleY = length(oriented.axisY);
+	oriented.axisX /= scaleX;
+	oriented.axisY /= scaleY;
+
+	if (shape.type == ShapeID::Circle)
+		oriented.halfSize = shape.halfSize * std::max(scaleX, scaleY);
+	else
+		oriented.halfSize = sf::Vector2f(shape.halfSize.x * scaleX, shape.halfSize.y * scaleY);
+
+	return oriented;
+}
+
+OrientedShape orientShape(const sf::FloatRect& rect)
+{
+	OrientedShape oriented;
+	oriented.type = ShapeID::Box;
+	oriented.centre = sf::Vector2f(rect.left + rect.width / 2.f, rect.top + rect.height / 2.f);
+	oriented.axisX = sf::Vector2f(1.f, 0.f);
+	oriented.axisY = sf::Vector2f(0.f, 1.f);
+	oriented.halfSize = sf::Vector2f(rect.width / 2.f, rect.height / 2.f);
+	return oriented;
+}
+
+bool intersects(const OrientedShape& lhs, const OrientedShape& rhs)
+{
+	if (lhs.type == ShapeID::Circle && rhs.type == ShapeID::Circle)
+		return circlesIntersect(lhs, rhs);
+	else if (lhs.type == ShapeID::Circle)
+		return boxIntersectsCircle(rhs, lhs);
+	else if (rhs.type == ShapeID::Circle)
+		return boxIntersectsCircle(lhs, rhs);
+	else
+		return boxesIntersect(lhs, rhs);
+}
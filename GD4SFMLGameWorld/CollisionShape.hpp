@@ -0,0 +1,33 @@
+#pragma once
+#include "ShapeID.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+
+// Collider outline in a node's local frame
+struct CollisionShape
+{
+	ShapeID type;
+	sf::Vector2f centre;
+	sf::Vector2f halfSize;	// A circle only uses x, as its radius
+};
+
+// The same outline placed in the world, with unit axes
+struct OrientedShape
+{
+	ShapeID type;
+	sf::Vector2f centre;
+	sf::Vector2f axisX;
+	sf::Vector2f axisY;
+	sf::Vector2f halfSize;
+};
+
+// Outlines around a sprite that was centred with centreOrigin()
+CollisionShape	boxShape(const sf::IntRect& textureRect);
+CollisionShape	circleShape(const sf::IntRect& textureRect, float radius);
+
+OrientedShape	orientShape(const CollisionShape& shape, const sf::Transform& transform);
+OrientedShape	orientShape(const sf::FloatRect& rect);
+
+// Touching outlines don't intersect, same as sf::FloatRect::intersects
+bool			intersects(const OrientedShape& lhs, const OrientedShape& rhs);
@@ -1,31 +1,44 @@
 #pragma once
 
 #include "CategoryID.hpp"
+#include "CategoryTraits.hpp"
+#include "InlineFunction.hpp"
 #include "SFML/System/Time.hpp"
 
-#include <functional>
 #include <cassert>
 
 class SceneNode;
 
 struct Command
 {
+	// Room for a few pointers or a position, which is all the game's command lambdas capture
+	typedef InlineFunction<void(SceneNode&, sf::Time), 32> Action;
+
 	Command();
-	std::function<void(SceneNode&, sf::Time)> action;
+	Action action;
 	unsigned int category;
 };
 
+// Command for the nodes of type GameObject, or only those in the given subset of its categories.
+// CategoryTraits guarantees the type of every node the command reaches, so no RTTI check is needed.
 template <typename GameObject, typename Function>
-std::function<void(SceneNode&, sf::Time)> derivedAction(Function fn)
+Command typedCommand(unsigned int category, Function fn)
 {
-	return [=](SceneNode& node, sf::Time dt)
-	{
-		//Check if the cast is safe
-		assert(dynamic_cast<GameObject*>(&node) != nullptr);
+	assert((category & ~CategoryTraits<GameObject>::Categories) == 0);
 
+	Command command;
+	command.category = category;
+	command.action = [=](SceneNode& node, sf::Time dt)
+	{
 		//Downcast node and invoke the function on it
 		fn(static_cast<GameObject&>(node), dt);
-
 	};
+	return command;
+}
+
+template <typename GameObject, typename Function>
+Command typedCommand(Function fn)
+{
+	return typedCommand<GameObject>(CategoryTraits<GameObject>::Categories, fn);
 }
 
@@ -1,18 +1,86 @@
 #include "CommandQueue.hpp"
+#include "AllocationCounter.hpp"
 
-void CommandQueue::push(const Command& command)
+#include <cassert>
+#include <utility>
+
+namespace
+{
+	std::size_t roundUpToPowerOfTwo(std::size_t value)
+	{
+		std::size_t result = 1;
+		while (result < value)
+			result *= 2;
+		return result;
+	}
+}
+
+CommandQueue::CommandQueue(std::size_t capacity)
+	: mCurrent()
+	, mNext()
+	, mAllocationCount(0)
+{
+	capacity = roundUpToPowerOfTwo(capacity);
+	mCurrent = { std::vector<Command>(capacity), 0, 0 };
+	mNext = { std::vector<Command>(capacity), 0, 0 };
+}
+
+void CommandQueue::push(Command&& command)
 {
-	mQueue.push(command);
+	// Running out of room is the only way to allocate, the counter makes it show up
+	if (mNext.size == mNext.slots.size())
+	{
+		std::size_t allocations = getThreadAllocationCount();
+		grow(mNext);
+		mAllocationCount += getThreadAllocationCount() - allocations;
+	}
+
+	std::size_t mask = mNext.slots.size() - 1;
+	mNext.slots[(mNext.head + mNext.size) & mask] = std::move(command);
+	++mNext.size;
 }
 
 Command CommandQueue::pop()
 {
-	Command command = mQueue.front();
-	mQueue.pop();
-	return Command(command);
+	assert(!isEmpty());
+
+	Command command = std::move(mCurrent.slots[mCurrent.head]);
+	mCurrent.head = (mCurrent.head + 1) & (mCurrent.slots.size() - 1);
+	--mCurrent.size;
+	return command;
 }
 
 bool CommandQueue::isEmpty() const
 {
-	return mQueue.empty();
+	return mCurrent.size == 0;
+}
+
+void CommandQueue::swapBuffers()
+{
+	// Leftovers of the current batch would otherwise be lost
+	assert(isEmpty());
+
+	std::swap(mCurrent, mNext);
+}
+
+std::size_t CommandQueue::getAllocationCount() const
+{
+	return mAllocationCount;
+}
+
+void CommandQueue::resetAllocationCount()
+{
+	mAllocationCount = 0;
+}
+
+void CommandQueue::grow(Buffer& buffer)
+{
+	// Unroll the ring into a buffer twice as big, oldest command first
+	std::vector<Command> slots(buffer.slots.size() * 2);
+	std::size_t mask = buffer.slots.size() - 1;
+	for (std::size_t i = 0; i < buffer.size; ++i)
+		slots[i] = std::move(buffer.slots[(buffer.head + i) & mask]);
+
+	buffer.slots.swap(slots);
+	buffer.head = 0;
 }
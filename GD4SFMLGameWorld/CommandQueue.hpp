@@ -1,15 +1,40 @@
 #pragma once
 #include "Command.hpp"
 
-#include <queue>
+#include <SFML/System/NonCopyable.hpp>
 
-class CommandQueue
+#include <vector>
+
+// Commands are double buffered: push() always adds to the next batch, while pop() drains the current one.
+// swapBuffers() turns everything pushed so far into the batch to drain, so commands produced while a batch
+// is being dispatched (or during the scene update) wait for the next tick instead of mixing in.
+// Each batch is a ring buffer with reserved capacity, commands are moved in and out without allocating.
+class CommandQueue : private sf::NonCopyable
 {
 public:
-	void push(const Command& command);
+	explicit CommandQueue(std::size_t capacity = 256);
+
+	void push(Command&& command);
 	Command pop();
 	bool isEmpty() const;
+	void swapBuffers();
+
+	// Heap allocations made while pushing and popping since the last reset
+	std::size_t getAllocationCount() const;
+	void resetAllocationCount();
+
+private:
+	struct Buffer
+	{
+		std::vector<Command> slots;	// Power of two size
+		std::size_t head;
+		std::size_t size;
+	};
+
+	void grow(Buffer& buffer);
 
 private:
-	std::queue<Command> mQueue;
-};
\ No newline at end of file
+	Buffer mCurrent;
+	Buffer mNext;
+	std::size_t mAllocationCount;
+};
@@ -0,0 +1,8 @@
+#pragma once
+//Lifecycle of a touching pair between two ticks
+enum class ContactID
+{
+	Enter,
+	Stay,
+	Exit
+};
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "ProjectileID.hpp"
 #include "PickupID.hpp"
 #include "ParticleID.hpp"
+#include "Utility.hpp"
+
+#include <cmath>
 
 
 
@@ -18,6 +21,7 @@ std::vector<AircraftData> initializeAircraftData()
 	data[static_cast<int>(PersonID::Player)].speed = 200.f;
 	data[static_cast<int>(PersonID::Player)].fireInterval = sf::seconds(1);
 	data[static_cast<int>(PersonID::Player)].textureRect = sf::IntRect(0, 0, 48, 100);
+	data[static_cast<int>(PersonID::Player)].shape = boxShape(data[static_cast<int>(PersonID::Player)].textureRect);
 	data[static_cast<int>(PersonID::Player)].texture = TextureID::Entities;
 	data[static_cast<int>(PersonID::Player)].hasRollAnimation = true;
 
@@ -25,6 +29,7 @@ std::vector<AircraftData> initializeAircraftData()
 	data[static_cast<int>(PersonID::Player2)].speed = 200.f;
 	data[static_cast<int>(PersonID::Player2)].fireInterval = sf::seconds(1);
 	data[static_cast<int>(PersonID::Player2)].textureRect = sf::IntRect(0, 0, 48, 100);
+	data[static_cast<int>(PersonID::Player2)].shape = boxShape(data[static_cast<int>(PersonID::Player2)].textureRect);
 	data[static_cast<int>(PersonID::Player2)].texture = TextureID::Entities;
 	data[static_cast<int>(PersonID::Player2)].hasRollAnimation = true;
 
@@ -33,6 +38,7 @@ std::vector<AircraftData> initializeAircraftData()
 	data[static_cast<int>(PersonID::Zombie)].fireInterval = sf::Time::Zero;
 	data[static_cast<int>(PersonID::Zombie)].texture = TextureID::Entities;
 	data[static_cast<int>(PersonID::Zombie)].textureRect = sf::IntRect(228, 0, 50, 100);
+	data[static_cast<int>(PersonID::Zombie)].shape = boxShape(data[static_cast<int>(PersonID::Zombie)].textureRect);
 
 	data[static_cast<int>(PersonID::Zombie)].directions.push_back(Direction(+20.f, 80.f));
 	data[static_cast<int>(PersonID::Zombie)].directions.push_back(Direction(-20.f, 80.f));
@@ -44,6 +50,7 @@ std::vector<AircraftData> initializeAircraftData()
 	data[static_cast<int>(PersonID::SpecialZombie)].fireInterval = sf::seconds(2);
 	data[static_cast<int>(PersonID::SpecialZombie)].texture = TextureID::Entities;
 	data[static_cast<int>(PersonID::SpecialZombie)].textureRect = sf::IntRect(150, 0, 70, 100);
+	data[static_cast<int>(PersonID::SpecialZombie)].shape = boxShape(data[static_cast<int>(PersonID::SpecialZombie)].textureRect);
 	data[static_cast<int>(PersonID::SpecialZombie)].directions.push_back(Direction(+30.f, 50.f));
 	data[static_cast<int>(PersonID::SpecialZombie)].directions.push_back(Direction(-50.f, 50.f));
 	data[static_cast<int>(PersonID::SpecialZombie)].directions.push_back(Direction(+30.f, 100.f));
@@ -52,6 +59,16 @@ std::vector<AircraftData> initializeAircraftData()
 	data[static_cast<int>(PersonID::SpecialZombie)].hasRollAnimation = false;
 	data[static_cast<int>(PersonID::SpecialZombie)].hasRollAnimation = false;
 
+	// Angles are measured from straight down, so movement patterns never need trigonometry at runtime
+	for (AircraftData& aircraft : data)
+	{
+		for (Direction& direction : aircraft.directions)
+		{
+			float radians = toRadian(direction.angle + 90.f);
+			direction.unit = sf::Vector2f(std::cos(radians), std::sin(radians));
+		}
+	}
+
 	return data;
 }
 
@@ -63,17 +80,20 @@ std::vector<ProjectileData> initializeProjectileData()
 	data[static_cast<int>(ProjectileID::AlliedBullet)].speed = 300.f;
 	data[static_cast<int>(ProjectileID::AlliedBullet)].texture = TextureID::Entities;
 	data[static_cast<int>(ProjectileID::AlliedBullet)].textureRect = sf::IntRect(175, 64, 3, 14);
+	data[static_cast<int>(ProjectileID::AlliedBullet)].shape = boxShape(data[static_cast<int>(ProjectileID::AlliedBullet)].textureRect);
 
 	data[static_cast<int>(ProjectileID::EnemyBullet)].damage = 10;
 	data[static_cast<int>(ProjectileID::EnemyBullet)].speed = 300.f;
 	data[static_cast<int>(ProjectileID::EnemyBullet)].texture = TextureID::Entities;
 	data[static_cast<int>(ProjectileID::EnemyBullet)].textureRect = sf::IntRect(175, 64, 3, 14);
+	data[static_cast<int>(ProjectileID::EnemyBullet)].shape = boxShape(data[static_cast<int>(ProjectileID::EnemyBullet)].textureRect);
 
 
 	data[static_cast<int>(ProjectileID::Missile)].damage = 200;
 	data[static_cast<int>(ProjectileID::Missile)].speed = 250.f;
 	data[static_cast<int>(ProjectileID::Missile)].texture = TextureID::Entities;
 	data[static_cast<int>(ProjectileID::Missile)].textureRect = sf::IntRect(160, 64, 15, 32);
+	data[static_cast<int>(ProjectileID::Missile)].shape = boxShape(data[static_cast<int>(ProjectileID::Missile)].textureRect);
 
 	return data;
 }
@@ -83,18 +103,22 @@ std::vector<PickupData> initializePickupData()
 	std::vector<PickupData> data(static_cast<int>(PickupID::TypeCount));
 	data[static_cast<int>(PickupID::HealthRefill)].texture = TextureID::Entities;
 	data[static_cast<int>(PickupID::HealthRefill)].textureRect = sf::IntRect(0, 64, 40, 40);
+	data[static_cast<int>(PickupID::HealthRefill)].shape = circleShape(data[static_cast<int>(PickupID::HealthRefill)].textureRect, 20.f);
 	data[static_cast<int>(PickupID::HealthRefill)].action = [](Aircraft& a) {a.repair(25); };
 
 	data[static_cast<int>(PickupID::MissileRefill)].texture = TextureID::Entities;
 	data[static_cast<int>(PickupID::MissileRefill)].textureRect = sf::IntRect(40, 64, 40, 40);
+	data[static_cast<int>(PickupID::MissileRefill)].shape = circleShape(data[static_cast<int>(PickupID::MissileRefill)].textureRect, 20.f);
 	data[static_cast<int>(PickupID::MissileRefill)].action = std::bind(&Aircraft::collectMissiles, std::placeholders::_1, 3);
 
 	data[static_cast<int>(PickupID::FireSpread)].texture = TextureID::Entities;
 	data[static_cast<int>(PickupID::FireSpread)].textureRect = sf::IntRect(80, 64, 40, 40);
+	data[static_cast<int>(PickupID::FireSpread)].shape = circleShape(data[static_cast<int>(PickupID::FireSpread)].textureRect, 20.f);
 	data[static_cast<int>(PickupID::FireSpread)].action = std::bind(&Aircraft::increaseSpread, std::placeholders::_1);
 
 	data[static_cast<int>(PickupID::FireRate)].texture = TextureID::Entities;
 	data[static_cast<int>(PickupID::FireRate)].textureRect = sf::IntRect(120, 64, 40, 40);
+	data[static_cast<int>(PickupID::FireRate)].shape = circleShape(data[static_cast<int>(PickupID::FireRate)].textureRect, 20.f);
 	data[static_cast<int>(PickupID::FireRate)].action = std::bind(&Aircraft::increaseFireRate, std::placeholders::_1);
 
 	return data;
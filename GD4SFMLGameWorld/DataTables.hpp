@@ -2,10 +2,12 @@
 
 #include "ResourceIdentifiers.hpp"
 #include "TextureID.hpp"
+#include "CollisionShape.hpp"
 
 #include <SFML/System/Time.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
 
 #include <vector>
 #include <functional>
@@ -15,11 +17,12 @@ class Aircraft;
 struct Direction
 {
 	Direction(float angle, float distance)
-		:angle(angle), distance(distance)
+		:angle(angle), distance(distance), unit()
 	{}
 
 	float angle;
 	float distance;
+	sf::Vector2f unit;	// Heading of angle, filled in with the table
 };
 
 struct AircraftData
@@ -28,6 +31,7 @@ struct AircraftData
 	float speed;
 	TextureID texture;
 	sf::IntRect textureRect;
+	CollisionShape shape;
 	sf::Time fireInterval;
 	std::vector<Direction> directions;
 	bool hasRollAnimation;
@@ -39,6 +43,7 @@ struct ProjectileData
 	float speed;
 	TextureID texture;
 	sf::IntRect textureRect;
+	CollisionShape shape;
 };
 
 struct PickupData
@@ -46,6 +51,7 @@ struct PickupData
 	std::function<void(Aircraft&)> action;
 	TextureID texture;
 	sf::IntRect textureRect;
+	CollisionShape shape;
 };
 
 struct ParticleData
@@ -1,51 +1,52 @@
 #include "EmitterNode.hpp"
 #include "ParticleNode.hpp"
+#include "CategoryRegistry.hpp"
 
 #include <iostream>
 
 EmitterNode::EmitterNode(ParticleID type)
-	:SceneNode()
+	:SceneNode(CategoryID::ParticleEmitter)
 	, mAccumulatedTime(sf::Time::Zero)
 	, mType(type)
 	, mParticleSystem(nullptr)
 {
 }
 
-void EmitterNode::updateCurrent(sf::Time dt, CommandQueue& commands)
+void EmitterNode::updateCurrent(sf::Time dt, CommandQueue&)
 {
 	if (mParticleSystem)
 	{
-		emitParticles(dt);
-	}
-	else
-	{
-		//Find particle node that has the same type as me
-		auto finder = [this](ParticleNode& container, sf::Time)
-		{
-			if (container.getParticleType() == mType)
-			{
-				mParticleSystem = &container;
-			}
-		};
-
-		Command command;
-		command.category = static_cast<int>(CategoryID::ParticleSystem);
-		command.action = derivedAction<ParticleNode>(finder);
-
-		commands.push(command);
+		mAccumulatedTime += dt;
 	}
 }
 
-void EmitterNode::emitParticles(sf::Time dt)
+void EmitterNode::onRegistered(CategoryRegistry& registry)
+{
+	//Bind to the particle node that has the same type as me
+	mParticleSystem = registry.getParticleSystem(mType);
+}
+
+void EmitterNode::onUnregistered()
 {
+	mParticleSystem = nullptr;
+}
+
+void EmitterNode::emitParticles()
+{
+	if (!mParticleSystem)
+		return;
+
 	const float emissionRate = 30.f;
 	const sf::Time interval = sf::seconds(1.f) / emissionRate;
 
-	mAccumulatedTime += dt;
-
+	std::size_t count = 0;
 	while (mAccumulatedTime > interval)
 	{
 		mAccumulatedTime -= interval;
-		mParticleSystem->addParticle(getWorldPosition());
+		++count;
 	}
+
+	//All particles of a tick start where the emitter is now, add them in one go
+	if (count > 0)
+		mParticleSystem->addParticles(getWorldPosition(), count);
 }
@@ -2,17 +2,22 @@
 #include "SceneNode.hpp"
 #include "Particle.hpp"
 #include "ParticleID.hpp"
+#include "PoolAllocated.hpp"
 
 class ParticleNode;
 
-class EmitterNode : public SceneNode
+class EmitterNode : public SceneNode, public PoolAllocated<EmitterNode>
 {
 public:
 	explicit EmitterNode(ParticleID type);
 
+	// Adds the particles due since the last call, once the parent has moved for this tick
+	void emitParticles();
+
 private:
 	virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
-	void emitParticles(sf::Time dt);
+	virtual void onRegistered(CategoryRegistry& registry);
+	virtual void onUnregistered();
 
 private:
 	sf::Time mAccumulatedTime;
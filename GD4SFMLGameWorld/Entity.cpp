@@ -1,48 +1,101 @@
 #include "Entity.hpp"
+#include "EntityTable.hpp"
 
 #include <cassert>
 #include <iostream>
 
 Entity::Entity(int hitpoints)
-	: mVelocity(), mHitpoints(hitpoints)
+	: mVelocity(), mHitpoints(hitpoints), mTable(nullptr), mHandle(), mComponent(0)
 {}
 
+Entity::~Entity()
+{
+	if (mTable)
+		mTable->remove(*this);
+}
+
 void Entity::setVelocity(sf::Vector2f velocity)
 {
-	mVelocity = velocity;
+	if (mTable)
+	{
+		mTable->mVelocitiesX[mComponent] = velocity.x;
+		mTable->mVelocitiesY[mComponent] = velocity.y;
+	}
+	else
+	{
+		mVelocity = velocity;
+	}
 }
 
 void Entity::setVelocity(float vx, float vy)
 {
-	mVelocity.x = vx;
-	mVelocity.y = vy;
+	setVelocity(sf::Vector2f(vx, vy));
 }
 
 void Entity::accelerate(sf::Vector2f velocity)
 {
-	mVelocity += velocity;
+	setVelocity(getVelocity() + velocity);
 }
 
 void Entity::accelerate(float vx, float vy)
 {
-	mVelocity.x += vx;
-	mVelocity.y += vy;
+	setVelocity(getVelocity() + sf::Vector2f(vx, vy));
 }
 
 sf::Vector2f Entity::getVelocity() const
 {
+	if (mTable)
+		return sf::Vector2f(mTable->mVelocitiesX[mComponent], mTable->mVelocitiesY[mComponent]);
+
 	return mVelocity;
 }
 
+void Entity::setPosition(float x, float y)
+{
+	if (mTable)
+	{
+		mTable->mPositionsX[mComponent] = x;
+		mTable->mPositionsY[mComponent] = y;
+		invalidateWorldTransform();
+	}
+	else
+	{
+		SceneNode::setPosition(x, y);
+	}
+}
+
+void Entity::setPosition(const sf::Vector2f& position)
+{
+	setPosition(position.x, position.y);
+}
+
+sf::Vector2f Entity::getPosition() const
+{
+	if (mTable)
+		return sf::Vector2f(mTable->mPositionsX[mComponent], mTable->mPositionsY[mComponent]);
+
+	return SceneNode::getPosition();
+}
+
+void Entity::move(float offsetX, float offsetY)
+{
+	setPosition(getPosition() + sf::Vector2f(offsetX, offsetY));
+}
+
+void Entity::move(const sf::Vector2f& offset)
+{
+	setPosition(getPosition() + offset);
+}
+
 int Entity::getHitpoints() const
 {
-	return mHitpoints;
+	return mTable ? mTable->mHitpoints[mComponent] : mHitpoints;
 }
 
 void Entity::repair(int points)
 {
 	assert(points > 0);
-	mHitpoints += points;
+	setHitpoints(getHitpoints() + points);
 
 }
 
@@ -50,20 +103,59 @@ void Entity::repair(int points)
 void Entity::damage(int points)
 {
 	assert(points >= 0);
-	mHitpoints -= points;
+	bool wasDestroyed = isDestroyed();
+	setHitpoints(getHitpoints() - points);
+
+	if (!wasDestroyed && isDestroyed() && mTable)
+		mTable->addWreck(*this);
 }
 
 void Entity::destroy()
 {
-	mHitpoints = 0;
+	bool wasDestroyed = isDestroyed();
+	setHitpoints(0);
+
+	if (!wasDestroyed && mTable)
+		mTable->addWreck(*this);
 }
 
 bool Entity::isDestroyed() const
 {
-	return mHitpoints <= 0;
+	return getHitpoints() <= 0;
+}
+
+EntityHandle Entity::getHandle() const
+{
+	return mHandle;
+}
+
+EntityTable* Entity::getEntityTable() const
+{
+	return mTable;
 }
 
 void Entity::updateCurrent(sf::Time dt, CommandQueue&)
 {
-	move(mVelocity * dt.asSeconds());
+	// Entities in a table are moved all at once by EntityTable::integrate()
+	if (!mTable)
+		move(mVelocity * dt.asSeconds());
+}
+
+sf::Transform Entity::getLocalTransform() const
+{
+	if (!mTable)
+		return getTransform();
+
+	// Same as sf::Transformable::getTransform() with the table's position, the base's position being zero
+	sf::Transform transform;
+	transform.translate(mTable->mPositionsX[mComponent], mTable->mPositionsY[mComponent]);
+	return transform * getTransform();
+}
+
+void Entity::setHitpoints(int hitpoints)
+{
+	if (mTable)
+		mTable->mHitpoints[mComponent] = hitpoints;
+	else
+		mHitpoints = hitpoints;
 }
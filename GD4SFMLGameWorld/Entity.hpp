@@ -2,27 +2,53 @@
 #include "SFML/Graphics.hpp"
 #include "SceneNode.hpp"
 #include "CommandQueue.hpp"
+#include "EntityHandle.hpp"
+
+class EntityTable;
 
 class Entity : public SceneNode
 {
 public:
 	Entity(int hitpoints);
+	virtual ~Entity();
 	void setVelocity(sf::Vector2f velocity);
 	void setVelocity(float vx, float vy);
 	void accelerate(sf::Vector2f velocity);
 	void accelerate(float vx, float vy);
 	sf::Vector2f getVelocity() const;
 
+	// Hide the SceneNode versions, the position of an entity in a table is kept in its component arrays
+	void setPosition(float x, float y);
+	void setPosition(const sf::Vector2f& position);
+	sf::Vector2f getPosition() const;
+	void move(float offsetX, float offsetY);
+	void move(const sf::Vector2f& offset);
+
 	int getHitpoints() const;
 	void repair(int points);
 	void damage(int points);
 	void destroy();
 	virtual bool isDestroyed() const;
 
+	EntityHandle getHandle() const;
+	EntityTable* getEntityTable() const;
+
 protected:
 	virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
+	virtual sf::Transform getLocalTransform() const;
 
 private:
+	void setHitpoints(int hitpoints);
+
+private:
+	// Only used while the entity is outside a table, which keeps them in its component arrays otherwise.
+	// In a table, the position of the sf::Transformable base stays at the origin.
 	sf::Vector2f mVelocity;
 	int mHitpoints;
+
+	EntityTable* mTable;
+	EntityHandle mHandle;
+	std::size_t mComponent;
+
+	friend class EntityTable;
 };
\ No newline at end of file
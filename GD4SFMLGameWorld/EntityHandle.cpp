@@ -0,0 +1,53 @@
+#include "EntityHandle.hpp"
+
+#include <cassert>
+
+EntityHandle::EntityHandle()
+	: mValue(0)
+{
+}
+
+EntityHandle::EntityHandle(std::size_t index, unsigned int generation)
+	: mValue(static_cast<sf::Uint32>(generation) << IndexBits | static_cast<sf::Uint32>(index))
+{
+	// Generation 0 is kept for the null handle
+	assert(index <= MaxIndex);
+	assert(generation > 0 && generation <= MaxGeneration);
+}
+
+std::size_t EntityHandle::getIndex() const
+{
+	return mValue & MaxIndex;
+}
+
+unsigned int EntityHandle::getGeneration() const
+{
+	return mValue >> IndexBits;
+}
+
+sf::Uint32 EntityHandle::getValue() const
+{
+	return mValue;
+}
+
+bool EntityHandle::isNull() const
+{
+	return mValue == 0;
+}
+
+EntityHandle EntityHandle::fromValue(sf::Uint32 value)
+{
+	EntityHandle handle;
+	handle.mValue = value;
+	return handle;
+}
+
+bool operator==(EntityHandle lhs, EntityHandle rhs)
+{
+	return lhs.getValue() == rhs.getValue();
+}
+
+bool operator!=(EntityHandle lhs, EntityHandle rhs)
+{
+	return !(lhs == rhs);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SFML/Config.hpp>
+
+#include <cstddef>
+
+// Compact, stable reference to an entity in an EntityTable: the table slot in the low bits and
+// the slot's generation in the high bits. Once the entity is gone the handle no longer resolves,
+// even after its slot has been reused. The null handle never resolves.
+class EntityHandle
+{
+public:
+	static const unsigned int IndexBits = 20;
+	static const unsigned int GenerationBits = 32 - IndexBits;
+	static const std::size_t MaxIndex = (1u << IndexBits) - 1;
+	static const unsigned int MaxGeneration = (1u << GenerationBits) - 1;
+
+public:
+	EntityHandle();
+	EntityHandle(std::size_t index, unsigned int generation);
+
+	std::size_t getIndex() const;
+	unsigned int getGeneration() const;
+	sf::Uint32 getValue() const;
+	bool isNull() const;
+
+	static EntityHandle fromValue(sf::Uint32 value);
+
+private:
+	sf::Uint32 mValue;
+};
+
+bool operator==(EntityHandle lhs, EntityHandle rhs);
+bool operator!=(EntityHandle lhs, EntityHandle rhs);
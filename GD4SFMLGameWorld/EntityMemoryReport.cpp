@@ -0,0 +1,37 @@
+#include "EntityMemoryReport.hpp"
+#include "Aircraft.hpp"
+#include "Projectile.hpp"
+#include "Pickup.hpp"
+#include "EmitterNode.hpp"
+#include "TextNode.hpp"
+
+
+namespace
+{
+	template <typename Type>
+	void printSize(std::ostream& out, const char* name)
+	{
+		out << name << ": " << sizeof(Type) << " bytes\n";
+	}
+}
+
+void runEntityMemoryReport(std::ostream& out)
+{
+	printSize<SceneNode>(out, "SceneNode");
+	printSize<Entity>(out, "Entity");
+	printSize<Aircraft>(out, "Aircraft");
+	out << "Aircraft player state: " << Aircraft::getPlayerStateSize() << " bytes (players only)\n";
+	out << "Aircraft death state: " << Aircraft::getDeathStateSize() << " bytes (once destroyed)\n";
+	printSize<Projectile>(out, "Projectile");
+	printSize<Pickup>(out, "Pickup");
+	printSize<EmitterNode>(out, "EmitterNode");
+	printSize<TextNode>(out, "TextNode");
+
+	// A zombie is an Aircraft block from its pool, plus the node showing its hitpoints.
+	// Strings, vertex arrays and child lists allocate on top of that.
+	const std::size_t zombies = 1000;
+	std::size_t alive = Aircraft::getPool().getBlockSize() + sizeof(TextNode);
+	std::size_t dying = alive + Aircraft::getDeathStateSize();
+	out << "Per " << zombies << " zombies: " << alive * zombies / 1024 << " KiB alive, "
+		<< dying * zombies / 1024 << " KiB while dying\n";
+}
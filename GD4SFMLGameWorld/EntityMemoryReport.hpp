@@ -0,0 +1,6 @@
+#pragma once
+#include <ostream>
+
+// Prints the size of each entity type and what a horde of zombies costs in node memory.
+// Build with ENTITY_MEMORY_REPORT defined to run it from main instead of the game.
+void runEntityMemoryReport(std::ostream& out);
@@ -0,0 +1,195 @@
+#include "EntityTable.hpp"
+#include "SteeringBatch.hpp"
+
+#include <cassert>
+#include <cmath>
+
+EntityTable::EntityTable()
+	: mSlots()
+	, mFreeSlots()
+	, mWrecks()
+	, mOwners()
+	, mPositionsX()
+	, mPositionsY()
+	, mVelocitiesX()
+	, mVelocitiesY()
+	, mHitpoints()
+{
+}
+
+EntityTable::~EntityTable()
+{
+	// Entities that outlive the table must not reach back into it, they take their components along
+	for (Entity* entity : mOwners)
+	{
+		entity->SceneNode::setPosition(mPositionsX[entity->mComponent], mPositionsY[entity->mComponent]);
+		entity->mVelocity = sf::Vector2f(mVelocitiesX[entity->mComponent], mVelocitiesY[entity->mComponent]);
+		entity->mHitpoints = mHitpoints[entity->mComponent];
+		entity->mTable = nullptr;
+	}
+}
+
+Entity* EntityTable::get(EntityHandle handle) const
+{
+	std::size_t index = handle.getIndex();
+	if (handle.isNull() || index >= mSlots.size())
+		return nullptr;
+
+	const Slot& slot = mSlots[index];
+	return slot.generation == handle.getGeneration() ? slot.entity : nullptr;
+}
+
+std::size_t EntityTable::getSize() const
+{
+	return mOwners.size();
+}
+
+std::size_t EntityTable::getComponent(const Entity& entity) const
+{
+	assert(entity.mTable == this);
+	return entity.mComponent;
+}
+
+void EntityTable::removeWrecks()
+{
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < mWrecks.size(); ++i)
+	{
+		// Wrecks deleted along with their parent, or repaired, have nothing left to do here
+		Entity* wreck = get(mWrecks[i]);
+		if (!wreck || !wreck->isDestroyed())
+			continue;
+
+		SceneNode* parent = wreck->getParent();
+		if (parent && wreck->isMarkedForRemoval())
+			parent->detachChild(*wreck);
+		else if (parent)
+			mWrecks[kept++] = mWrecks[i];
+	}
+
+	mWrecks.resize(kept);
+}
+
+void EntityTable::integrate(sf::Time dt)
+{
+	// Branch free, so the compiler can vectorize it. Destroyed entities stay where they died.
+	std::size_t count = mOwners.size();
+	float seconds = dt.asSeconds();
+	float* positionsX = mPositionsX.data();
+	float* positionsY = mPositionsY.data();
+	const float* velocitiesX = mVelocitiesX.data();
+	const float* velocitiesY = mVelocitiesY.data();
+	const int* hitpoints = mHitpoints.data();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		float step = hitpoints[i] > 0 ? seconds : 0.f;
+		positionsX[i] += velocitiesX[i] * step;
+		positionsY[i] += velocitiesY[i] * step;
+	}
+
+	// The nodes read their new position from here once their world transform is needed again
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (hitpoints[i] > 0 && (velocitiesX[i] != 0.f || velocitiesY[i] != 0.f))
+			mOwners[i]->invalidateWorldTransform();
+	}
+}
+
+void EntityTable::steer(const SteeringBatch& batch)
+{
+	// Branch free like integrate(), only the stores are scattered over the table
+	std::size_t count = batch.size();
+	const std::size_t* components = batch.components.data();
+	const float* steeredX = batch.velocitiesX.data();
+	const float* steeredY = batch.velocitiesY.data();
+	const float* turnsX = batch.turnsX.data();
+	const float* turnsY = batch.turnsY.data();
+	const float* speeds = batch.speeds.data();
+	float* velocitiesX = mVelocitiesX.data();
+	float* velocitiesY = mVelocitiesY.data();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		float x = steeredX[i] + turnsX[i];
+		float y = steeredY[i] + turnsY[i];
+		float length = std::sqrt(x * x + y * y);
+		float scale = speeds[i] > 0.f ? speeds[i] / length : 1.f;
+		velocitiesX[components[i]] = x * scale;
+		velocitiesY[components[i]] = y * scale;
+	}
+}
+
+void EntityTable::add(Entity& entity)
+{
+	assert(!entity.mTable);
+
+	std::size_t index;
+	if (!mFreeSlots.empty())
+	{
+		index = mFreeSlots.back();
+		mFreeSlots.pop_back();
+	}
+	else
+	{
+		index = mSlots.size();
+		mSlots.push_back({ nullptr, 1 });
+	}
+
+	Slot& slot = mSlots[index];
+	slot.entity = &entity;
+	entity.mTable = this;
+	entity.mHandle = EntityHandle(index, slot.generation);
+
+	// The table takes over the position, the node's own one is left at the origin
+	sf::Vector2f position = entity.SceneNode::getPosition();
+	entity.SceneNode::setPosition(0.f, 0.f);
+	entity.mComponent = mOwners.size();
+	mOwners.push_back(&entity);
+	mPositionsX.push_back(position.x);
+	mPositionsY.push_back(position.y);
+	mVelocitiesX.push_back(entity.mVelocity.x);
+	mVelocitiesY.push_back(entity.mVelocity.y);
+	mHitpoints.push_back(entity.mHitpoints);
+}
+
+void EntityTable::remove(Entity& entity)
+{
+	assert(entity.mTable == this);
+
+	// A new generation makes the old handles stale, skipping 0 which is only used by the null handle
+	Slot& slot = mSlots[entity.mHandle.getIndex()];
+	assert(slot.entity == &entity);
+	slot.entity = nullptr;
+	slot.generation = slot.generation == EntityHandle::MaxGeneration ? 1 : slot.generation + 1;
+	mFreeSlots.push_back(entity.mHandle.getIndex());
+
+	// Hand the components back to the entity, and move the last ones into the gap
+	std::size_t component = entity.mComponent;
+	entity.SceneNode::setPosition(mPositionsX[component], mPositionsY[component]);
+	entity.mVelocity = sf::Vector2f(mVelocitiesX[component], mVelocitiesY[component]);
+	entity.mHitpoints = mHitpoints[component];
+
+	std::size_t last = mOwners.size() - 1;
+	mOwners[component] = mOwners[last];
+	mOwners[component]->mComponent = component;
+	mPositionsX[component] = mPositionsX[last];
+	mPositionsY[component] = mPositionsY[last];
+	mVelocitiesX[component] = mVelocitiesX[last];
+	mVelocitiesY[component] = mVelocitiesY[last];
+	mHitpoints[component] = mHitpoints[last];
+
+	mOwners.pop_back();
+	mPositionsX.pop_back();
+	mPositionsY.pop_back();
+	mVelocitiesX.pop_back();
+	mVelocitiesY.pop_back();
+	mHitpoints.pop_back();
+
+	entity.mTable = nullptr;
+	entity.mHandle = EntityHandle();
+}
+
+void EntityTable::addWreck(Entity& entity)
+{
+	assert(entity.mTable == this);
+	mWrecks.push_back(entity.mHandle);
+}
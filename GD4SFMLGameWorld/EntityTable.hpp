@@ -0,0 +1,91 @@
+#pragma once
+#include "Entity.hpp"
+#include "EntityHandle.hpp"
+#include "CategoryTraits.hpp"
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <vector>
+#include <memory>
+#include <utility>
+
+struct SteeringBatch;
+
+// Hands out a handle to every entity it creates and resolves handles back in O(1).
+// Entities leave the table when they are destroyed, after which their handles resolve to null.
+// Entities that lose their last hitpoint are listed as wrecks, so their removal only has to visit those.
+// The data touched by every entity every tick (position, velocity, hitpoints) is owned by packed arrays,
+// so that movement is one loop over contiguous memory instead of a virtual call per node.
+// The nodes are views on it: Entity's position accessors and local transform read and write the arrays.
+class EntityTable : private sf::NonCopyable
+{
+public:
+	EntityTable();
+	~EntityTable();
+
+	template <typename GameObject, typename... Args>
+	std::unique_ptr<GameObject> create(Args&&... args);
+
+	Entity* get(EntityHandle handle) const;
+	template <typename GameObject>
+	GameObject* get(EntityHandle handle) const;
+
+	std::size_t getSize() const;
+	// Where the entity's components are in the packed arrays, valid until the next entity leaves the table
+	std::size_t getComponent(const Entity& entity) const;
+
+	// Detaches and deletes the wrecks that are marked for removal, the others are kept for a later tick
+	void removeWrecks();
+
+	// Moves every entity that is still alive by its velocity, the moved nodes only get their world transform invalidated
+	void integrate(sf::Time dt);
+
+	// Writes the velocities of a steering batch straight into the component arrays
+	void steer(const SteeringBatch& batch);
+
+private:
+	void add(Entity& entity);
+	void remove(Entity& entity);
+	void addWreck(Entity& entity);
+
+private:
+	struct Slot
+	{
+		Entity* entity;
+		unsigned int generation;
+	};
+
+	std::vector<Slot> mSlots;
+	std::vector<std::size_t> mFreeSlots;
+	std::vector<EntityHandle> mWrecks;
+
+	// Components of the live entities, packed at the front in no particular order
+	std::vector<Entity*> mOwners;
+	std::vector<float> mPositionsX;
+	std::vector<float> mPositionsY;
+	std::vector<float> mVelocitiesX;
+	std::vector<float> mVelocitiesY;
+	std::vector<int> mHitpoints;
+
+	friend class Entity;
+};
+
+template <typename GameObject, typename... Args>
+std::unique_ptr<GameObject> EntityTable::create(Args&&... args)
+{
+	std::unique_ptr<GameObject> entity(new GameObject(std::forward<Args>(args)...));
+	add(*entity);
+	return entity;
+}
+
+template <typename GameObject>
+GameObject* EntityTable::get(EntityHandle handle) const
+{
+	// A handle always resolves to the same entity, only its category can tell the type
+	Entity* entity = get(handle);
+	if (!entity || !(entity->getCategory() & CategoryTraits<GameObject>::Categories))
+		return nullptr;
+
+	return static_cast<GameObject*>(entity);
+}
@@ -0,0 +1,167 @@
+#include "FlatSceneGraph.hpp"
+#include "CommandQueue.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+
+FlatSceneGraph::FlatSceneGraph()
+	: mEntries()
+	, mInserted()
+	, mHoles(0)
+	, mUpdating(false)
+{
+}
+
+void FlatSceneGraph::update(sf::Time dt, CommandQueue& commands)
+{
+	if (mHoles > 0)
+		compact();
+
+	// Parents come before their children, the order SceneNode::update visits them in.
+	// Like there, nodes must not be attached during the update: insert() would shift the entries under the loop.
+	// Removing is fine, it only leaves holes.
+	mUpdating = true;
+	for (std::size_t i = 0; i < mEntries.size(); ++i)
+	{
+		if (SceneNode* node = mEntries[i].node)
+			node->updateCurrent(dt, commands);
+	}
+	mUpdating = false;
+}
+
+std::size_t FlatSceneGraph::getNodeCount() const
+{
+	return mEntries.size() - mHoles;
+}
+
+void FlatSceneGraph::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	// The cached world transform is the product of all local transforms down to the node, as in SceneNode::draw
+	for (const Entry& entry : mEntries)
+	{
+		if (!entry.node)
+			continue;
+
+		sf::RenderStates nodeStates(states);
+		nodeStates.transform *= entry.node->getWorldTransform();
+		entry.node->drawCurrent(target, nodeStates);
+	}
+}
+
+void FlatSceneGraph::build(SceneNode& root)
+{
+	clear();
+	flatten(root, NoParent, 0, mEntries);
+}
+
+void FlatSceneGraph::clear()
+{
+	for (const Entry& entry : mEntries)
+	{
+		if (entry.node)
+			entry.node->mFlatGraph = nullptr;
+	}
+
+	mEntries.clear();
+	mHoles = 0;
+}
+
+void FlatSceneGraph::insert(SceneNode& node)
+{
+	assert(node.mParent && node.mParent->mFlatGraph == this);
+	assert(!node.mFlatGraph);
+	assert(!mUpdating);
+
+	// The subtree goes right behind the last node of its parent's subtree, the position a new last child has
+	std::size_t parent = node.mParent->mFlatIndex;
+	std::size_t position = mEntries[parent].end;
+	mInserted.clear();
+	flatten(node, parent, position, mInserted);
+	std::size_t count = mInserted.size();
+
+	// Everything behind the insertion point moves back, and the subtrees containing it grow
+	for (std::size_t i = position; i < mEntries.size(); ++i)
+	{
+		Entry& entry = mEntries[i];
+		if (entry.node)
+			entry.node->mFlatIndex += count;
+		if (entry.parent != NoParent && entry.parent >= position)
+			entry.parent += count;
+		entry.end += count;
+	}
+	for (std::size_t ancestor = parent; ancestor != NoParent; ancestor = mEntries[ancestor].parent)
+		mEntries[ancestor].end += count;
+
+	mEntries.insert(mEntries.begin() + position, mInserted.begin(), mInserted.end());
+}
+
+void FlatSceneGraph::remove(SceneNode& node)
+{
+	assert(node.mFlatGraph == this);
+
+	// Detached subtrees stay intact, only their entries here are cleared
+	Entry& first = mEntries[node.mFlatIndex];
+	for (std::size_t i = node.mFlatIndex; i < first.end; ++i)
+	{
+		Entry& entry = mEntries[i];
+		if (entry.node)
+		{
+			entry.node->mFlatGraph = nullptr;
+			entry.node = nullptr;
+			++mHoles;
+		}
+	}
+}
+
+void FlatSceneGraph::erase(SceneNode& node)
+{
+	assert(node.mFlatGraph == this);
+
+	// Called as the node is destroyed, its children follow right after
+	mEntries[node.mFlatIndex].node = nullptr;
+	node.mFlatGraph = nullptr;
+	++mHoles;
+}
+
+void FlatSceneGraph::compact()
+{
+	// Parents are moved before their children, so a child finds its parent's new index on the parent node
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < mEntries.size(); ++i)
+	{
+		Entry entry = mEntries[i];
+		if (!entry.node)
+			continue;
+
+		entry.parent = entry.node->mParent ? entry.node->mParent->mFlatIndex : NoParent;
+		entry.end = count + 1;
+		entry.node->mFlatIndex = count;
+		mEntries[count++] = entry;
+	}
+	mEntries.resize(count);
+
+	// Each subtree ends where the subtree of its last child ends
+	for (std::size_t i = count; i-- > 1;)
+	{
+		Entry& parent = mEntries[mEntries[i].parent];
+		parent.end = std::max(parent.end, mEntries[i].end);
+	}
+
+	mHoles = 0;
+}
+
+void FlatSceneGraph::flatten(SceneNode& node, std::size_t parent, std::size_t first, std::vector<Entry>& entries)
+{
+	std::size_t index = first + entries.size();
+	node.mFlatGraph = this;
+	node.mFlatIndex = index;
+	entries.push_back({ &node, parent, index + 1 });
+
+	for (const SceneNode::Ptr& child : node.mChildren)
+		flatten(*child, index, first, entries);
+
+	entries[index - first].end = first + entries.size();
+}
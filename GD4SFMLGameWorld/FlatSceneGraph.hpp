@@ -0,0 +1,54 @@
+#pragma once
+#include "SceneNode.hpp"
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+
+#include <vector>
+
+class CommandQueue;
+
+// Depth-first array of the nodes below a scene graph root, kept in step as subtrees get attached and detached.
+// Every entry knows its parent's index and where its subtree ends, so the per-tick traversals
+// are forward loops over contiguous memory instead of recursive walks through each node's children.
+// Detached and destroyed nodes leave holes behind, which update() closes in a single pass.
+// Commands and wreck removal do not walk the tree, CategoryRegistry and EntityTable take care of those.
+class FlatSceneGraph : public sf::Drawable, private sf::NonCopyable
+{
+public:
+	FlatSceneGraph();
+
+	// Same result as SceneNode::update called on the root, nodes must not be attached meanwhile
+	void update(sf::Time dt, CommandQueue& commands);
+
+	std::size_t getNodeCount() const;
+
+private:
+	static const std::size_t NoParent = static_cast<std::size_t>(-1);
+
+	struct Entry
+	{
+		SceneNode* node;	// Null for the hole left by a removed node
+		std::size_t parent;
+		std::size_t end;	// One past the last node of the subtree
+	};
+
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+	void build(SceneNode& root);
+	void clear();
+	void insert(SceneNode& node);
+	void remove(SceneNode& node);
+	void erase(SceneNode& node);
+	void compact();
+	void flatten(SceneNode& node, std::size_t parent, std::size_t first, std::vector<Entry>& entries);
+
+private:
+	std::vector<Entry> mEntries;
+	std::vector<Entry> mInserted;
+	std::size_t mHoles;
+	bool mUpdating;
+
+	friend class SceneNode;
+};
@@ -0,0 +1,85 @@
+#include "FrameArena.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+
+
+FrameArena::FrameArena(std::size_t capacity)
+	: mBuffer(new unsigned char[capacity])
+	, mCapacity(capacity)
+	, mOffset(0)
+	, mRequested(0)
+	, mHighWaterMark(0)
+	, mOverflowCount(0)
+{
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+	// Neither the buffer nor the heap fallback is aligned any stricter than this
+	assert(alignment <= alignof(std::max_align_t));
+
+	mRequested += size;
+	if (mRequested > mHighWaterMark)
+		mHighWaterMark = mRequested;
+
+	std::size_t start = (mOffset + alignment - 1) & ~(alignment - 1);
+	if (start + size > mCapacity)
+	{
+		// Out of scratch memory, the frame still works but pays for it
+		++mOverflowCount;
+		return ::operator new(size);
+	}
+
+	mOffset = start + size;
+	return mBuffer.get() + start;
+}
+
+void FrameArena::deallocate(void* memory, std::size_t size)
+{
+	if (!owns(memory))
+	{
+		::operator delete(memory);
+		return;
+	}
+
+	// A container that grows frees its previous block right after allocating the next one,
+	// so only the newest block can be given back early
+	unsigned char* block = static_cast<unsigned char*>(memory);
+	if (block + size == mBuffer.get() + mOffset)
+		mOffset = block - mBuffer.get();
+}
+
+void FrameArena::reset()
+{
+	mOffset = 0;
+	mRequested = 0;
+}
+
+std::size_t FrameArena::getCapacity() const
+{
+	return mCapacity;
+}
+
+std::size_t FrameArena::getUsed() const
+{
+	return mOffset;
+}
+
+std::size_t FrameArena::getHighWaterMark() const
+{
+	return mHighWaterMark;
+}
+
+std::size_t FrameArena::getOverflowCount() const
+{
+	return mOverflowCount;
+}
+
+bool FrameArena::owns(const void* memory) const
+{
+	const unsigned char* block = static_cast<const unsigned char*>(memory);
+	return block >= mBuffer.get() && block < mBuffer.get() + mCapacity;
+}
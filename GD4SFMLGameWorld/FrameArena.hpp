@@ -0,0 +1,35 @@
+#pragma once
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+
+// Linear scratch memory for data that only lives during one tick. Allocating bumps an offset,
+// freeing does nothing (except for the latest block), and reset() hands back everything at once.
+// Requests that do not fit fall back to the heap and are counted, the high-water mark tells how big the arena should be.
+class FrameArena : private sf::NonCopyable
+{
+public:
+	explicit FrameArena(std::size_t capacity);
+
+	void* allocate(std::size_t size, std::size_t alignment);
+	void deallocate(void* memory, std::size_t size);
+	void reset();
+
+	std::size_t getCapacity() const;
+	std::size_t getUsed() const;
+	std::size_t getHighWaterMark() const;	// Most bytes requested within one frame, overflow included
+	std::size_t getOverflowCount() const;	// Heap fallbacks since construction
+
+private:
+	bool owns(const void* memory) const;
+
+private:
+	std::unique_ptr<unsigned char[]> mBuffer;
+	std::size_t mCapacity;
+	std::size_t mOffset;
+	std::size_t mRequested;
+	std::size_t mHighWaterMark;
+	std::size_t mOverflowCount;
+};
@@ -1,11 +1,23 @@
 #include "GameState.hpp"
+#include "ResourceHolder.hpp"
+#include "Utility.hpp"
+
+#include <SFML/Graphics/RenderWindow.hpp>
 
 GameState::GameState(StateStack& stack, Context context)
 	:State(stack, context)
 	, mWorld(*context.window, *context.fonts, *context.sounds)
 	, mPlayer(*context.player)
 	, mPlayer2(*context.player2)
+	, mStatisticsText()
+	, mStatisticsUpdateTime()
+	, mCommandAllocations(0)
+	, mPoolReuses(mWorld.getEntityPoolReuses())
 {
+	mStatisticsText.setFont(context.fonts->get(FontID::Main));
+	mStatisticsText.setPosition(5.f, 55.f);
+	mStatisticsText.setCharacterSize(20);
+
 	mPlayer.setMissionStatus(MissionStatusID::MissionRunning);
 	mPlayer2.setMissionStatus(MissionStatusID::MissionRunning);
 	context.music->play(MusicID::MissionTheme);
@@ -14,11 +26,16 @@ GameState::GameState(StateStack& stack, Context context)
 void GameState::draw()
 {
 	mWorld.draw();
+
+	sf::RenderWindow& window = *getContext().window;
+	window.setView(window.getDefaultView());
+	window.draw(mStatisticsText);
 }
 
 bool GameState::update(sf::Time dt)
 {
 	mWorld.update(dt);
+	updateStatistics(dt);
 
 	if (!mWorld.hasAlivePlayer())
 	{
@@ -32,18 +49,16 @@ bool GameState::update(sf::Time dt)
 		requestStackPush(StateID::GameOver);
 	}
 
-	CommandQueue& commands = mWorld.getCommandQueue();
-	mPlayer.handleRealtimeInput(commands);
-	mPlayer2.handleRealtimeInput(commands);
+	mWorld.setPlayerInput(mPlayer.handleRealtimeInput());
+	mWorld.setPlayer2Input(mPlayer2.handleRealtimeInput());
 
 	return true;
 }
 
 bool GameState::handleEvent(const sf::Event& event)
 {
-	CommandQueue& commands = mWorld.getCommandQueue();
-	mPlayer.handleEvent(event, commands);
-	mPlayer2.handleEvent(event, commands);
+	mPlayer.handleEvent(event);
+	mPlayer2.handleEvent(event);
 
 	//Pause if esc is pressed
 	if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)
@@ -52,3 +67,25 @@ bool GameState::handleEvent(const sf::Event& event)
 	}
 	return true;
 }
+
+void GameState::updateStatistics(sf::Time dt)
+{
+	mStatisticsUpdateTime += dt;
+	mCommandAllocations += mWorld.getCommandAllocations();
+
+	// Command allocations count everything the command path took from the heap during the last second (commands, and what they create),
+	// the pool chunk count only goes up when more entities are alive than the pools were sized for.
+	// The arena's peak is what it should be sized to, overflows fell back to the heap.
+	if (mStatisticsUpdateTime >= sf::seconds(1.0f))
+	{
+		std::size_t poolReuses = mWorld.getEntityPoolReuses();
+		const FrameArena& arena = mWorld.getFrameArena();
+		mStatisticsText.setString("Command allocations = " + toString(mCommandAllocations) + "\n" +
+			"Entity pool chunks = " + toString(mWorld.getEntityPoolAllocations()) + ", reused blocks/s = " + toString(poolReuses - mPoolReuses) + "\n" +
+			"Frame arena peak = " + toString(arena.getHighWaterMark()) + "/" + toString(arena.getCapacity()) + " bytes, overflows = " + toString(arena.getOverflowCount()));
+
+		mStatisticsUpdateTime -= sf::seconds(1.0f);
+		mCommandAllocations = 0;
+		mPoolReuses = poolReuses;
+	}
+}
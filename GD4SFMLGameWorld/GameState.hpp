@@ -17,8 +17,17 @@ public:
 	virtual bool update(sf::Time dt);
 	virtual bool handleEvent(const sf::Event& event);
 
+private:
+	void updateStatistics(sf::Time dt);
+
 private:
 	World mWorld;
 	Player& mPlayer;
 	Player2& mPlayer2;
+
+	// World counters, shown below the application's frame statistics and refreshed once per second
+	sf::Text mStatisticsText;
+	sf::Time mStatisticsUpdateTime;
+	std::size_t mCommandAllocations;
+	std::size_t mPoolReuses;
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Callable wrapper like std::function, but the wrapped function object is always stored
+// in a fixed buffer inside the wrapper, so constructing and copying it never allocates.
+// Function objects that do not fit the buffer are rejected at compile time.
+template <typename Signature, std::size_t Capacity>
+class InlineFunction;
+
+template <typename Result, typename... Args, std::size_t Capacity>
+class InlineFunction<Result(Args...), Capacity>
+{
+public:
+	InlineFunction();
+	template <typename Function, typename = typename std::enable_if<!std::is_same<typename std::decay<Function>::type, InlineFunction>::value>::type>
+	InlineFunction(Function&& fn);
+	InlineFunction(const InlineFunction& other);
+	InlineFunction(InlineFunction&& other);
+	~InlineFunction();
+
+	InlineFunction& operator=(const InlineFunction& other);
+	InlineFunction& operator=(InlineFunction&& other);
+
+	Result operator()(Args... args) const;
+	explicit operator bool() const;
+
+private:
+	struct Operations
+	{
+		Result(*invoke)(void* storage, Args&&... args);
+		void(*copy)(void* destination, const void* source);
+		void(*move)(void* destination, void* source);
+		void(*destroy)(void* storage);
+	};
+
+	template <typename Function>
+	static const Operations* getOperations();
+
+	void reset();
+
+private:
+	typename std::aligned_storage<Capacity, alignof(std::max_align_t)>::type mStorage;
+	const Operations* mOperations;
+};
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>::InlineFunction()
+	: mStorage()
+	, mOperations(nullptr)
+{
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+template <typename Function, typename>
+InlineFunction<Result(Args...), Capacity>::InlineFunction(Function&& fn)
+	: mStorage()
+	, mOperations(nullptr)
+{
+	typedef typename std::decay<Function>::type Stored;
+	static_assert(sizeof(Stored) <= Capacity, "Function object does not fit the inline buffer, capture less or raise the capacity");
+	static_assert(alignof(std::max_align_t) % alignof(Stored) == 0, "Function object is over-aligned for the inline buffer");
+	static_assert(std::is_copy_constructible<Stored>::value, "Function object must be copyable");
+
+	new (&mStorage) Stored(std::forward<Function>(fn));
+	mOperations = getOperations<Stored>();
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>::InlineFunction(const InlineFunction& other)
+	: mStorage()
+	, mOperations(other.mOperations)
+{
+	if (mOperations)
+		mOperations->copy(&mStorage, &other.mStorage);
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>::InlineFunction(InlineFunction&& other)
+	: mStorage()
+	, mOperations(other.mOperations)
+{
+	if (mOperations)
+		mOperations->move(&mStorage, &other.mStorage);
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>::~InlineFunction()
+{
+	reset();
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>& InlineFunction<Result(Args...), Capacity>::operator=(const InlineFunction& other)
+{
+	if (this != &other)
+	{
+		reset();
+		if (other.mOperations)
+			other.mOperations->copy(&mStorage, &other.mStorage);
+		mOperations = other.mOperations;
+	}
+	return *this;
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>& InlineFunction<Result(Args...), Capacity>::operator=(InlineFunction&& other)
+{
+	if (this != &other)
+	{
+		reset();
+		if (other.mOperations)
+			other.mOperations->move(&mStorage, &other.mStorage);
+		mOperations = other.mOperations;
+	}
+	return *this;
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+Result InlineFunction<Result(Args...), Capacity>::operator()(Args... args) const
+{
+	assert(mOperations != nullptr);
+
+	// Like std::function, a const wrapper may still call a mutable function object
+	return mOperations->invoke(const_cast<void*>(static_cast<const void*>(&mStorage)), std::forward<Args>(args)...);
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>::operator bool() const
+{
+	return mOperations != nullptr;
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+template <typename Function>
+const typename InlineFunction<Result(Args...), Capacity>::Operations* InlineFunction<Result(Args...), Capacity>::getOperations()
+{
+	// One table per stored type, shared by all wrappers holding that type
+	static const Operations operations =
+	{
+		[](void* storage, Args&&... args) -> Result
+		{
+			return (*static_cast<Function*>(storage))(std::forward<Args>(args)...);
+		},
+		[](void* destination, const void* source)
+		{
+			new (destination) Function(*static_cast<const Function*>(source));
+		},
+		[](void* destination, void* source)
+		{
+			new (destination) Function(std::move(*static_cast<Function*>(source)));
+		},
+		[](void* storage)
+		{
+			static_cast<Function*>(storage)->~Function();
+		}
+	};
+
+	return &operations;
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+void InlineFunction<Result(Args...), Capacity>::reset()
+{
+	if (mOperations)
+		mOperations->destroy(&mStorage);
+	mOperations = nullptr;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+//Buttons held in a PlayerInput, one bit each
+enum class InputButtonID
+{
+	None = 0,
+	Fire = 1 << 0,
+	LaunchMissile = 1 << 1,
+};
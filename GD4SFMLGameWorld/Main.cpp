@@ -1,9 +1,19 @@
 #include <stdexcept>
 #include <iostream>
 #include "Application.hpp"
+#include "CollisionBenchmark.hpp"
+#include "SceneGraphBenchmark.hpp"
+#include "EntityMemoryReport.hpp"
 
 int main()
 {
+#if defined(COLLISION_BENCHMARK)
+	runCollisionBenchmark(std::cout);
+#elif defined(SCENE_GRAPH_BENCHMARK)
+	runSceneGraphBenchmark(std::cout);
+#elif defined(ENTITY_MEMORY_REPORT)
+	runEntityMemoryReport(std::cout);
+#else
 	try 
 	{
 		Application theAmazingGame;
@@ -13,4 +23,5 @@ int main()
 	{
 		std::cout << "\n EXCEPTION" << e.what() << std::endl;
 	}
+#endif
 }
\ No newline at end of file
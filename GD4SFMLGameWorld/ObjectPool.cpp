@@ -0,0 +1,108 @@
+#include "ObjectPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	std::size_t roundUp(std::size_t size, std::size_t alignment)
+	{
+		return (size + alignment - 1) / alignment * alignment;
+	}
+}
+
+ObjectPool::ObjectPool(std::size_t blockSize, std::size_t blocksPerChunk)
+	: mBlockSize(roundUp(std::max(blockSize, sizeof(FreeBlock)), alignof(std::max_align_t)))
+	, mBlocksPerChunk(blocksPerChunk)
+	, mChunks()
+	, mFreeList(nullptr)
+	, mLiveCount(0)
+	, mHeapAllocationCount(0)
+	, mReuseCount(0)
+	, mRecycledCount(0)
+{
+	assert(blocksPerChunk > 0);
+}
+
+void* ObjectPool::allocate()
+{
+	if (!mFreeList)
+		grow();
+
+	// Blocks handed back by deallocate() sit in front of the fresh ones
+	if (mRecycledCount > 0)
+	{
+		--mRecycledCount;
+		++mReuseCount;
+	}
+
+	FreeBlock* block = mFreeList;
+	mFreeList = block->next;
+	++mLiveCount;
+	return block;
+}
+
+void ObjectPool::deallocate(void* block)
+{
+	if (!block)
+		return;
+
+	assert(mLiveCount > 0);
+	FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+	freeBlock->next = mFreeList;
+	mFreeList = freeBlock;
+	--mLiveCount;
+	++mRecycledCount;
+}
+
+void ObjectPool::reserve(std::size_t capacity)
+{
+	while (getCapacity() < capacity)
+		grow();
+}
+
+std::size_t ObjectPool::getBlockSize() const
+{
+	return mBlockSize;
+}
+
+std::size_t ObjectPool::getCapacity() const
+{
+	return mChunks.size() * mBlocksPerChunk;
+}
+
+std::size_t ObjectPool::getLiveCount() const
+{
+	return mLiveCount;
+}
+
+std::size_t ObjectPool::getHeapAllocationCount() const
+{
+	return mHeapAllocationCount;
+}
+
+std::size_t ObjectPool::getReuseCount() const
+{
+	return mReuseCount;
+}
+
+void ObjectPool::grow()
+{
+	std::unique_ptr<unsigned char[]> chunk(new unsigned char[mBlockSize * mBlocksPerChunk]);
+	++mHeapAllocationCount;
+
+	// Thread the new blocks onto the end of the free list, so recycled ones are still used first
+	FreeBlock** tail = &mFreeList;
+	while (*tail)
+		tail = &(*tail)->next;
+
+	for (std::size_t i = 0; i < mBlocksPerChunk; ++i)
+	{
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk.get() + i * mBlockSize);
+		*tail = block;
+		tail = &block->next;
+	}
+	*tail = nullptr;
+
+	mChunks.push_back(std::move(chunk));
+}
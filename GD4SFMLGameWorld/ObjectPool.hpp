@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Fixed-size memory blocks carved out of larger chunks and recycled through a free list.
+// Once the pool has grown to the peak number of live objects, allocating and freeing never touch the heap.
+class ObjectPool : private sf::NonCopyable
+{
+public:
+	ObjectPool(std::size_t blockSize, std::size_t blocksPerChunk);
+
+	void* allocate();
+	void deallocate(void* block);
+	void reserve(std::size_t capacity);
+
+	std::size_t getBlockSize() const;
+	std::size_t getCapacity() const;
+	std::size_t getLiveCount() const;
+	std::size_t getHeapAllocationCount() const;	// Chunks requested from the heap so far
+	std::size_t getReuseCount() const;			// Allocations served from a recycled block
+
+private:
+	void grow();
+
+private:
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	std::size_t mBlockSize;
+	std::size_t mBlocksPerChunk;
+	std::vector<std::unique_ptr<unsigned char[]>> mChunks;
+	FreeBlock* mFreeList;
+	std::size_t mLiveCount;
+	std::size_t mHeapAllocationCount;
+	std::size_t mReuseCount;
+	std::size_t mRecycledCount;
+};
@@ -21,13 +21,18 @@ ParticleNode::ParticleNode(ParticleID type, const TextureHolder& textures)
 }
 
 void ParticleNode::addParticle(sf::Vector2f position)
+{
+	addParticles(position, 1);
+}
+
+void ParticleNode::addParticles(sf::Vector2f position, std::size_t count)
 {
 	Particle particle;
 	particle.position = position;
 	particle.color = Table[static_cast<int>(mType)].color;
 	particle.lifetime = Table[static_cast<int>(mType)].lifetime;
 
-	mParticles.push_back(particle);
+	mParticles.insert(mParticles.end(), count, particle);
 }
 
 ParticleID ParticleNode::getParticleType() const
@@ -14,6 +14,7 @@ public:
 	ParticleNode(ParticleID type, const TextureHolder& textures);
 
 	void addParticle(sf::Vector2f position);
+	void addParticles(sf::Vector2f position, std::size_t count);
 	ParticleID getParticleType() const;
 	virtual unsigned int getCategory() const;
 
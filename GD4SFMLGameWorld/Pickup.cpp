@@ -31,6 +31,16 @@ sf::FloatRect Pickup::getBoundingRect() const
 	return getWorldTransform().transformRect(mSprite.getGlobalBounds());
 }
 
+const CollisionShape* Pickup::getCollisionShape() const
+{
+	return &Table[static_cast<int>(mType)].shape;
+}
+
+const sf::Sprite* Pickup::getCollisionSprite() const
+{
+	return &mSprite;
+}
+
 void Pickup::apply(Aircraft& player) const
 {
 	Table[static_cast<int>(mType)].action(player);
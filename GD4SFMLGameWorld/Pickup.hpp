@@ -3,19 +3,22 @@
 #include "Command.hpp"
 #include "ResourceIdentifiers.hpp"
 #include "PickUpID.hpp"
+#include "PoolAllocated.hpp"
 
 #include <SFML/Graphics/Sprite.hpp>
 
 
 class Aircraft;
 
-class Pickup : public Entity
+class Pickup : public Entity, public PoolAllocated<Pickup>
 {
 public:
 	Pickup(PickupID type, const TextureHolder& textures);
 
 	virtual unsigned int	getCategory() const;
 	virtual sf::FloatRect	getBoundingRect() const;
+	virtual const CollisionShape*	getCollisionShape() const;
+	virtual const sf::Sprite*		getCollisionSprite() const;
 
 	void 					apply(Aircraft& player) const;
 
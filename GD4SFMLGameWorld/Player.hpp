@@ -1,20 +1,18 @@
 #pragma once
-#include "Command.hpp"
+#include "PlayerInput.hpp"
 #include "ActionID.hpp"
 #include "MissionStatusID.hpp"
 
 #include <SFML/Window/Event.hpp>
 #include <map>
 
-class CommandQueue;
-
 class Player
 {
 public:
 	Player();
 
-	void handleEvent(const sf::Event& event, CommandQueue& commands);
-	void handleRealtimeInput(CommandQueue& commands);
+	void handleEvent(const sf::Event& event);
+	PlayerInput handleRealtimeInput();
 
 	void assignKey(ActionID action, sf::Keyboard::Key key);
 	sf::Keyboard::Key getAssignedKey(ActionID action) const;
@@ -23,11 +21,10 @@ public:
 	MissionStatusID getMissionStatus() const;
 
 private:
-	void initializeActions();
 	static bool isRealtimeAction(ActionID action);
 
 private:
 	std::map<sf::Keyboard::Key, ActionID> mKeyBinding;
-	std::map<ActionID, Command> mActionBinding;
+	PlayerInput mPendingInput;
 	MissionStatusID mCurrentMissionStatus;
 };
\ No newline at end of file
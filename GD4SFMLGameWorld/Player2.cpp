@@ -1,6 +1,4 @@
 #include "Player2.hpp"
-#include "CommandQueue.hpp"
-#include "Aircraft.hpp"
 #include "ActionID.hpp"
 
 #include <map>
@@ -9,22 +7,7 @@
 #include <iostream>
 
 
-struct AircraftMover
-{
-	AircraftMover(float vx, float vy)
-		: velocity(vx, vy)
-	{
-	}
-
-	void operator() (Aircraft& aircraft, sf::Time) const
-	{
-		aircraft.accelerate(velocity * aircraft.getMaxSpeed());
-	}
-
-	sf::Vector2f velocity;
-};
-
-Player2::Player2() : mCurrentMissionStatus(MissionStatusID::MissionRunning)
+Player2::Player2() : mPendingInput(), mCurrentMissionStatus(MissionStatusID::MissionRunning)
 {
 	// Set initial key bindings
 
@@ -34,40 +17,38 @@ Player2::Player2() : mCurrentMissionStatus(MissionStatusID::MissionRunning)
 	mKeyBinding[sf::Keyboard::Down] = ActionID::MoveDown;
 	mKeyBinding[sf::Keyboard::Enter] = ActionID::Fire;
 	mKeyBinding[sf::Keyboard::Numpad0] = ActionID::LaunchMissile;
-
-	// Set initial action bindings
-	initializeActions();
-
-	// Assign all categories to player's aircraft
-	for (auto& pair : mActionBinding)
-		pair.second.category = static_cast<int>(CategoryID::Player2Aircraft);
 }
 
-void Player2::handleEvent(const sf::Event& event, CommandQueue& commands)
+void Player2::handleEvent(const sf::Event& event)
 {
 	if (event.type == sf::Event::KeyPressed)
 	{
-		// Check if pressed key appears in key binding, trigger command if so
+		// Check if pressed key appears in key binding, keep it for this tick's input if so
 		auto found = mKeyBinding.find(event.key.code);
 
 		if (found != mKeyBinding.end() && !isRealtimeAction(found->second))
 		{
-			commands.push(mActionBinding[found->second]);
+			mPendingInput.press(found->second);
 		}
 	}
 }
 
-void Player2::handleRealtimeInput(CommandQueue& commands)
+PlayerInput Player2::handleRealtimeInput()
 {
-	// Traverse all assigned keys and check if they are pressed
+	// Start from the one-shot actions pressed since the last tick
+	PlayerInput input = mPendingInput;
+	mPendingInput = PlayerInput();
+
+	// Traverse all assigned keys and add the ones that are held
 	for (auto pair : mKeyBinding)
 	{
-		// If key is pressed, lookup action and trigger corresponding command
 		if (sf::Keyboard::isKeyPressed(pair.first) && isRealtimeAction(pair.second))
 		{
-			commands.push(mActionBinding[pair.second]);
+			input.press(pair.second);
 		}
 	}
+
+	return input;
 }
 
 void Player2::assignKey(ActionID action, sf::Keyboard::Key key)
@@ -106,16 +87,6 @@ MissionStatusID Player2::getMissionStatus() const
 	return mCurrentMissionStatus;
 }
 
-void Player2::initializeActions()
-{
-	mActionBinding[ActionID::MoveLeft].action = derivedAction<Aircraft>(AircraftMover(-1, 0));
-	mActionBinding[ActionID::MoveRight].action = derivedAction<Aircraft>(AircraftMover(+1, 0));
-	mActionBinding[ActionID::MoveUp].action = derivedAction<Aircraft>(AircraftMover(0, -1));
-	mActionBinding[ActionID::MoveDown].action = derivedAction<Aircraft>(AircraftMover(0, +1));
-	mActionBinding[ActionID::Fire].action = derivedAction<Aircraft>([](Aircraft& a, sf::Time) { a.fire(); });
-	mActionBinding[ActionID::LaunchMissile].action = derivedAction<Aircraft>([](Aircraft& a, sf::Time) { a.launchMissile(); });
-}
-
 bool Player2::isRealtimeAction(ActionID action)
 {
 	switch (action)
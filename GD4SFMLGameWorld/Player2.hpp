@@ -1,21 +1,19 @@
 #pragma once
 #pragma once
-#include "Command.hpp"
+#include "PlayerInput.hpp"
 #include "ActionID.hpp"
 #include "MissionStatusID.hpp"
 
 #include <SFML/Window/Event.hpp>
 #include <map>
 
-class CommandQueue;
-
 class Player2
 {
 public:
 	Player2();
 
-	void handleEvent(const sf::Event& event, CommandQueue& commands);
-	void handleRealtimeInput(CommandQueue& commands);
+	void handleEvent(const sf::Event& event);
+	PlayerInput handleRealtimeInput();
 
 	void assignKey(ActionID action, sf::Keyboard::Key key);
 	sf::Keyboard::Key getAssignedKey(ActionID action) const;
@@ -24,11 +22,10 @@ public:
 	MissionStatusID getMissionStatus() const;
 
 private:
-	void initializeActions();
 	static bool isRealtimeAction(ActionID action);
 
 private:
 	std::map<sf::Keyboard::Key, ActionID> mKeyBinding;
-	std::map<ActionID, Command> mActionBinding;
+	PlayerInput mPendingInput;
 	MissionStatusID mCurrentMissionStatus;
 };
\ No newline at end of file
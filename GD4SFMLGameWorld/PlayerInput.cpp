@@ -0,0 +1,43 @@
+#include "PlayerInput.hpp"
+
+PlayerInput::PlayerInput() : moveX(0), moveY(0), buttons(static_cast<int>(InputButtonID::None))
+{
+}
+
+void PlayerInput::press(ActionID action)
+{
+	// Opposite directions cancel out, the same way their accelerations used to
+	switch (action)
+	{
+	case ActionID::MoveLeft:
+		--moveX;
+		break;
+	case ActionID::MoveRight:
+		++moveX;
+		break;
+	case ActionID::MoveUp:
+		--moveY;
+		break;
+	case ActionID::MoveDown:
+		++moveY;
+		break;
+	case ActionID::Fire:
+		buttons |= static_cast<int>(InputButtonID::Fire);
+		break;
+	case ActionID::LaunchMissile:
+		buttons |= static_cast<int>(InputButtonID::LaunchMissile);
+		break;
+	default:
+		break;
+	}
+}
+
+bool PlayerInput::isPressed(InputButtonID button) const
+{
+	return (buttons & static_cast<int>(button)) != 0;
+}
+
+sf::Vector2f PlayerInput::getMovement() const
+{
+	return sf::Vector2f(static_cast<float>(moveX), static_cast<float>(moveY));
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "ActionID.hpp"
+#include "InputButtonID.hpp"
+
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+
+// One player's input for a tick, reduced from all the keys held (or pressed) since the last tick.
+// Three bytes of plain data, so it can be recorded for replays or sent over the network as is.
+struct PlayerInput
+{
+	PlayerInput();
+
+	void press(ActionID action);
+	bool isPressed(InputButtonID button) const;
+	sf::Vector2f getMovement() const;
+
+	sf::Int8 moveX;		// -1 left, +1 right
+	sf::Int8 moveY;		// -1 up, +1 down
+	sf::Uint8 buttons;	// InputButtonID bits
+};
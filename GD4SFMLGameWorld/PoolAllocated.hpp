@@ -0,0 +1,41 @@
+#pragma once
+#include "ObjectPool.hpp"
+
+#include <cstddef>
+#include <cassert>
+
+// Base for scene nodes that are created and destroyed all the time (projectiles, pickups...).
+// Their memory comes from a pool shared by all objects of type T instead of the heap.
+// The constructor runs on every reuse, so a recycled object starts out exactly like a new one.
+template <typename T, std::size_t BlocksPerChunk = 64>
+class PoolAllocated
+{
+public:
+	static void*			operator new(std::size_t size);
+	static void				operator delete(void* memory);
+
+	static ObjectPool&		getPool();
+};
+
+template <typename T, std::size_t BlocksPerChunk>
+void* PoolAllocated<T, BlocksPerChunk>::operator new(std::size_t size)
+{
+	// Classes derived from T would need a pool of their own
+	assert(size <= getPool().getBlockSize());
+	static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types cannot be pooled");
+
+	return getPool().allocate();
+}
+
+template <typename T, std::size_t BlocksPerChunk>
+void PoolAllocated<T, BlocksPerChunk>::operator delete(void* memory)
+{
+	getPool().deallocate(memory);
+}
+
+template <typename T, std::size_t BlocksPerChunk>
+ObjectPool& PoolAllocated<T, BlocksPerChunk>::getPool()
+{
+	static ObjectPool pool(sizeof(T), BlocksPerChunk);
+	return pool;
+}
@@ -23,6 +23,7 @@ Projectile::Projectile(ProjectileID type, const TextureHolder& textures)
 	, mType(type)
 	, mSprite(textures.get(Table[static_cast<int>(type)].texture), Table[static_cast<int>(type)].textureRect)
 	, mTargetDirection()
+	, mLastMovement()
 {
 	centreOrigin(mSprite);
 
@@ -66,6 +67,9 @@ void Projectile::updateCurrent(sf::Time dt, CommandQueue& commands)
 		setVelocity(newVelocity);
 	}
 
+	// Bullets are small and fast, collisions sweep them along this path so they can't tunnel through at low tick rates.
+	// The velocity is final now, it is what the entity table integrates this tick.
+	mLastMovement = getVelocity() * dt.asSeconds();
 	Entity::updateCurrent(dt, commands);
 }
 
@@ -87,6 +91,21 @@ sf::FloatRect Projectile::getBoundingRect() const
 	return getWorldTransform().transformRect(mSprite.getGlobalBounds());
 }
 
+const CollisionShape* Projectile::getCollisionShape() const
+{
+	return &Table[static_cast<int>(mType)].shape;
+}
+
+const sf::Sprite* Projectile::getCollisionSprite() const
+{
+	return &mSprite;
+}
+
+sf::Vector2f Projectile::getLastMovement() const
+{
+	return mLastMovement;
+}
+
 float Projectile::getMaxSpeed() const
 {
 	return Table[static_cast<int>(mType)].speed;
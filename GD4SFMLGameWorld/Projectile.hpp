@@ -4,11 +4,12 @@
 #include "ResourceIdentifiers.hpp"
 #include "ProjectileID.hpp"
 #include "CommandQueue.hpp"
+#include "PoolAllocated.hpp"
 
 #include <SFML/Graphics/Sprite.hpp>
 
 
-class Projectile : public Entity
+class Projectile : public Entity, public PoolAllocated<Projectile>
 {
 public:
 	Projectile(ProjectileID type, const TextureHolder& textures);
@@ -18,6 +19,9 @@ public:
 
 	virtual unsigned int	getCategory() const;
 	virtual sf::FloatRect	getBoundingRect() const;
+	virtual sf::Vector2f	getLastMovement() const;
+	virtual const CollisionShape*	getCollisionShape() const;
+	virtual const sf::Sprite*		getCollisionSprite() const;
 	float					getMaxSpeed() const;
 	int						getDamage() const;
 
@@ -31,4 +35,5 @@ private:
 	ProjectileID			mType;
 	sf::Sprite				mSprite;
 	sf::Vector2f			mTargetDirection;
+	sf::Vector2f			mLastMovement;
 };
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "SceneGraphBenchmark.hpp"
+#include "SceneNode.hpp"
+#include "FlatSceneGraph.hpp"
+#include "CommandQueue.hpp"
+
+#include <SFML/Graphics/RenderTexture.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+	typedef std::chrono::high_resolution_clock Clock;
+
+	// Moves a little every update, about the cheapest work a real node does
+	class BenchmarkNode : public SceneNode
+	{
+	public:
+		BenchmarkNode()
+			: SceneNode(CategoryID::None)
+		{
+		}
+
+	private:
+		virtual void updateCurrent(sf::Time dt, CommandQueue&)
+		{
+			move(dt.asSeconds(), 0.f);
+		}
+	};
+
+	// Layers holding entities with a few children each, like the game's aircraft with their texts and emitters.
+	// The nodes are attached in a random order, so that neighbours in the tree are not neighbours in memory.
+	void buildScene(SceneNode& root, std::size_t count)
+	{
+		std::mt19937 generator(static_cast<unsigned int>(count));
+
+		std::vector<std::unique_ptr<BenchmarkNode>> nodes;
+		for (std::size_t i = 0; i < count; ++i)
+			nodes.push_back(std::unique_ptr<BenchmarkNode>(new BenchmarkNode()));
+		std::shuffle(nodes.begin(), nodes.end(), generator);
+
+		std::vector<SceneNode*> layers;
+		for (std::size_t i = 0; i < 4 && !nodes.empty(); ++i)
+		{
+			layers.push_back(nodes.back().get());
+			root.attachChild(std::move(nodes.back()));
+			nodes.pop_back();
+		}
+
+		std::uniform_int_distribution<std::size_t> pickLayer(0, layers.size() - 1);
+		std::uniform_int_distribution<std::size_t> pickChildCount(0, 2);
+		while (!nodes.empty())
+		{
+			SceneNode* entity = nodes.back().get();
+			layers[pickLayer(generator)]->attachChild(std::move(nodes.back()));
+			nodes.pop_back();
+
+			std::size_t children = std::min(nodes.size(), pickChildCount(generator));
+			for (std::size_t i = 0; i < children; ++i)
+			{
+				entity->attachChild(std::move(nodes.back()));
+				nodes.pop_back();
+			}
+		}
+	}
+
+	double toNanoseconds(Clock::duration duration, std::size_t visits)
+	{
+		return std::chrono::duration<double, std::nano>(duration).count() / visits;
+	}
+
+	void report(std::ostream& out, const char* traversal, Clock::duration treeTime, Clock::duration flatTime, std::size_t visits)
+	{
+		double treeNs = toNanoseconds(treeTime, visits);
+		double flatNs = toNanoseconds(flatTime, visits);
+		out << "  " << traversal << ": pointer tree " << treeNs << " ns/node, flattened " << flatNs << " ns/node, speedup " << treeNs / flatNs << "x\n";
+	}
+}
+
+void runSceneGraphBenchmark(std::ostream& out)
+{
+	// The nodes draw nothing themselves, so drawing only times the traversal and the transforms
+	sf::RenderTexture target;
+	target.create(1, 1);
+
+	const std::size_t counts[] = { 1000, 10000 };
+	for (std::size_t count : counts)
+	{
+		SceneNode tree;
+		buildScene(tree, count);
+
+		FlatSceneGraph flatGraph;
+		SceneNode flattened;
+		buildScene(flattened, count);
+		flattened.setFlatSceneGraph(&flatGraph);
+
+		// Repeated until each path visits about 50 million nodes per traversal.
+		// Every update moves all nodes, so each draw has to combine fresh transforms.
+		std::size_t repeats = std::max<std::size_t>(1, 50000000 / count);
+		CommandQueue commands;
+		sf::Time dt = sf::seconds(1.f / 60.f);
+
+		Clock::duration treeUpdate = Clock::duration::zero();
+		Clock::duration treeDraw = Clock::duration::zero();
+		for (std::size_t repeat = 0; repeat < repeats; ++repeat)
+		{
+			Clock::time_point start = Clock::now();
+			tree.update(dt, commands);
+			Clock::time_point updated = Clock::now();
+			target.draw(tree);
+			treeUpdate += updated - start;
+			treeDraw += Clock::now() - updated;
+		}
+
+		Clock::duration flatUpdate = Clock::duration::zero();
+		Clock::duration flatDraw = Clock::duration::zero();
+		for (std::size_t repeat = 0; repeat < repeats; ++repeat)
+		{
+			Clock::time_point start = Clock::now();
+			flatGraph.update(dt, commands);
+			Clock::time_point updated = Clock::now();
+			target.draw(flatGraph);
+			flatUpdate += updated - start;
+			flatDraw += Clock::now() - updated;
+		}
+
+		out << count << " nodes" << (flatGraph.getNodeCount() == count + 1 ? "" : " (NODES MISSING)") << "\n";
+		report(out, "update", treeUpdate, flatUpdate, count * repeats);
+		report(out, "draw", treeDraw, flatDraw, count * repeats);
+	}
+}
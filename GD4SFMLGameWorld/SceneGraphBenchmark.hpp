@@ -0,0 +1,6 @@
+#pragma once
+#include <ostream>
+
+// Times the recursive SceneNode traversals against the same scene flattened into a FlatSceneGraph.
+// Build with SCENE_GRAPH_BENCHMARK defined to run it from main instead of the game.
+void runSceneGraphBenchmark(std::ostream& out);
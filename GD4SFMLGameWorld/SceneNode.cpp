@@ -1,5 +1,7 @@
 #include "SceneNode.hpp"
 #include "Command.hpp"
+#include "CategoryRegistry.hpp"
+#include "FlatSceneGraph.hpp"
 #include "Utility.hpp"
 
 #include <SFML/Graphics/RectangleShape.hpp>
@@ -9,28 +11,77 @@
 #include <cassert>
 #include <cmath>
 
+namespace
+{
+	unsigned int NextSerial = 0;
+}
 
 SceneNode::SceneNode(CategoryID category)
 	: mChildren()
 	, mParent(nullptr)
+	, mChildSlot(0)
 	, mDefaultCategory(category)
+	, mSerial(NextSerial++)
+	, mWorldTransform()
+	, mWorldTransformDirty(true)
+	, mRegistry(nullptr)
+	, mRegistrySlot(0)
+	, mRegisteredCategory(0)
+	, mFlatGraph(nullptr)
+	, mFlatIndex(0)
+{
+}
+
+SceneNode::~SceneNode()
 {
+	// The children unregister themselves as they get destroyed
+	if (mRegistry)
+		mRegistry->remove(*this);
+	if (mFlatGraph)
+		mFlatGraph->erase(*this);
 }
 
 void SceneNode::attachChild(Ptr child)
 {
 	child->mParent = this;
+	child->mChildSlot = mChildren.size();
+	child->invalidateWorldTransform();
+	if (mRegistry)
+		child->registerSubtree(*mRegistry);
+	if (mFlatGraph)
+		mFlatGraph->insert(*child);
+
 	mChildren.push_back(std::move(child));
 }
 
 SceneNode::Ptr SceneNode::detachChild(const SceneNode& node)
 {
-	auto found = std::find_if(mChildren.begin(), mChildren.end(), [&](Ptr& p) { return p.get() == &node; });
-	assert(found != mChildren.end());
+	assert(node.mParent == this && mChildren[node.mChildSlot].get() == &node);
 
-	Ptr result = std::move(*found);
+	Ptr result = removeChild(node.mChildSlot);
 	result->mParent = nullptr;
-	mChildren.erase(found);
+	result->invalidateWorldTransform();
+	result->unregisterSubtree();
+	if (result->mFlatGraph)
+		result->mFlatGraph->remove(*result);
+	return result;
+}
+
+SceneNode* SceneNode::getParent() const
+{
+	return mParent;
+}
+
+SceneNode::Ptr SceneNode::removeChild(std::size_t slot)
+{
+	// Fill the gap with the last child, the order of siblings does not matter
+	Ptr result = std::move(mChildren[slot]);
+	if (slot + 1 < mChildren.size())
+	{
+		mChildren[slot] = std::move(mChildren.back());
+		mChildren[slot]->mChildSlot = slot;
+	}
+	mChildren.pop_back();
 	return result;
 }
 
@@ -54,7 +105,7 @@ void SceneNode::updateChildren(sf::Time dt, CommandQueue& commands)
 void SceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
 	// Apply transform of current node
-	states.transform *= getTransform();
+	states.transform *= getLocalTransform();
 
 	// Draw node and children with changed transform
 	drawCurrent(target, states);
@@ -94,14 +145,109 @@ sf::Vector2f SceneNode::getWorldPosition() const
 	return getWorldTransform() * sf::Vector2f();
 }
 
-sf::Transform SceneNode::getWorldTransform() const
+const sf::Transform& SceneNode::getWorldTransform() const
+{
+	// Only recombine with the parent when this node or one of its ancestors has moved since the last call
+	if (mWorldTransformDirty)
+	{
+		if (mParent)
+			mWorldTransform = mParent->getWorldTransform() * getLocalTransform();
+		else
+			mWorldTransform = getLocalTransform();
+
+		mWorldTransformDirty = false;
+	}
+
+	return mWorldTransform;
+}
+
+sf::Transform SceneNode::getLocalTransform() const
+{
+	// Nodes that keep their position elsewhere build the transform from it
+	return getTransform();
+}
+
+void SceneNode::invalidateWorldTransform()
+{
+	// A dirty node always has a dirty subtree, so there is no need to descend any further
+	if (mWorldTransformDirty)
+		return;
+
+	mWorldTransformDirty = true;
+	for (Ptr& child : mChildren)
+		child->invalidateWorldTransform();
+}
+
+void SceneNode::setPosition(float x, float y)
+{
+	sf::Transformable::setPosition(x, y);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setPosition(const sf::Vector2f& position)
+{
+	sf::Transformable::setPosition(position);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setRotation(float angle)
+{
+	sf::Transformable::setRotation(angle);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setScale(float factorX, float factorY)
 {
-	sf::Transform transform = sf::Transform::Identity;
+	sf::Transformable::setScale(factorX, factorY);
+	invalidateWorldTransform();
+}
 
-	for (const SceneNode* node = this; node != nullptr; node = node->mParent)
-		transform = node->getTransform() * transform;
+void SceneNode::setScale(const sf::Vector2f& factors)
+{
+	sf::Transformable::setScale(factors);
+	invalidateWorldTransform();
+}
 
-	return transform;
+void SceneNode::setOrigin(float x, float y)
+{
+	sf::Transformable::setOrigin(x, y);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setOrigin(const sf::Vector2f& origin)
+{
+	sf::Transformable::setOrigin(origin);
+	invalidateWorldTransform();
+}
+
+void SceneNode::move(float offsetX, float offsetY)
+{
+	sf::Transformable::move(offsetX, offsetY);
+	invalidateWorldTransform();
+}
+
+void SceneNode::move(const sf::Vector2f& offset)
+{
+	sf::Transformable::move(offset);
+	invalidateWorldTransform();
+}
+
+void SceneNode::rotate(float angle)
+{
+	sf::Transformable::rotate(angle);
+	invalidateWorldTransform();
+}
+
+void SceneNode::scale(float factorX, float factorY)
+{
+	sf::Transformable::scale(factorX, factorY);
+	invalidateWorldTransform();
+}
+
+void SceneNode::scale(const sf::Vector2f& factor)
+{
+	sf::Transformable::scale(factor);
+	invalidateWorldTransform();
 }
 
 void SceneNode::onCommand(const Command& command, sf::Time dt)
@@ -120,31 +266,82 @@ unsigned int SceneNode::getCategory() const
 	return static_cast<int>(mDefaultCategory);
 }
 
-void SceneNode::checkSceneCollision(SceneNode& sceneGraph, std::set<Pair>& collisionPairs)
+unsigned int SceneNode::getSerial() const
 {
-	checkNodeCollision(sceneGraph, collisionPairs);
-
-	for (Ptr& child : sceneGraph.mChildren)
-		checkSceneCollision(*child, collisionPairs);
+	// Unlike the node's address, a serial is never handed out twice
+	return mSerial;
 }
 
-void SceneNode::checkNodeCollision(SceneNode& node, std::set<Pair>& collisionPairs)
+void SceneNode::collectCollidables(std::vector<SceneNode*>& collidables)
 {
-	if (this != &node && collision(*this, node) && !isDestroyed() && !node.isDestroyed())
-		collisionPairs.insert(std::minmax(this, &node));
+	// Gather this node and its subtree, skipping destroyed nodes that cannot collide anymore
+	if (!isDestroyed())
+		collidables.push_back(this);
 
 	for (Ptr& child : mChildren)
-		child->checkNodeCollision(node, collisionPairs);
+		child->collectCollidables(collidables);
 }
 
 void SceneNode::removeWrecks()
 {
-	// Remove all children which request so
-	auto wreckfieldBegin = std::remove_if(mChildren.begin(), mChildren.end(), std::mem_fn(&SceneNode::isMarkedForRemoval));
-	mChildren.erase(wreckfieldBegin, mChildren.end());
+	// Remove all children which request so, and call function recursively for all remaining children
+	std::size_t slot = 0;
+	while (slot < mChildren.size())
+	{
+		if (mChildren[slot]->isMarkedForRemoval())
+			removeChild(slot);
+		else
+			mChildren[slot++]->removeWrecks();
+	}
+}
+
+void SceneNode::setCategoryRegistry(CategoryRegistry* registry)
+{
+	assert(!mParent);
 
-	// Call function recursively for all remaining children
-	std::for_each(mChildren.begin(), mChildren.end(), std::mem_fn(&SceneNode::removeWrecks));
+	unregisterSubtree();
+	if (registry)
+		registerSubtree(*registry);
+}
+
+void SceneNode::setFlatSceneGraph(FlatSceneGraph* graph)
+{
+	assert(!mParent);
+
+	if (mFlatGraph)
+		mFlatGraph->clear();
+	if (graph)
+		graph->build(*this);
+}
+
+void SceneNode::registerSubtree(CategoryRegistry& registry)
+{
+	registry.add(*this);
+	onRegistered(registry);
+	for (Ptr& child : mChildren)
+		child->registerSubtree(registry);
+}
+
+void SceneNode::unregisterSubtree()
+{
+	if (mRegistry)
+	{
+		mRegistry->remove(*this);
+		onUnregistered();
+	}
+
+	for (Ptr& child : mChildren)
+		child->unregisterSubtree();
+}
+
+void SceneNode::onRegistered(CategoryRegistry&)
+{
+	// Nothing to look up by default
+}
+
+void SceneNode::onUnregistered()
+{
+	// Nothing to let go of by default
 }
 
 sf::FloatRect SceneNode::getBoundingRect() const
@@ -152,6 +349,24 @@ sf::FloatRect SceneNode::getBoundingRect() const
 	return sf::FloatRect();
 }
 
+sf::Vector2f SceneNode::getLastMovement() const
+{
+	// Nodes are collision tested where they are, unless they report how far they moved during the last update
+	return sf::Vector2f();
+}
+
+const CollisionShape* SceneNode::getCollisionShape() const
+{
+	// Without an outline of its own the bounding rect is all there is to collide with
+	return nullptr;
+}
+
+const sf::Sprite* SceneNode::getCollisionSprite() const
+{
+	// Nodes that return their sprite are only hit where its pixels are solid
+	return nullptr;
+}
+
 bool SceneNode::isMarkedForRemoval() const
 {
 	// By default, remove node if entity is destroyed
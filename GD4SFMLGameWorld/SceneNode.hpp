@@ -9,7 +9,15 @@
 
 #include <vector>
 #include <memory>
-#include <set>
+
+struct CollisionShape;
+class CategoryRegistry;
+class FlatSceneGraph;
+
+namespace sf
+{
+	class Sprite;
+}
 
 class SceneNode : public sf::Transformable, public sf::Drawable, private sf::NonCopyable
 {
@@ -19,39 +27,86 @@ public:
 
 public:
 	SceneNode(CategoryID category = CategoryID::None);
+	virtual ~SceneNode();
+
 	void attachChild(Ptr child);
 	Ptr detachChild(const SceneNode& node);
+	SceneNode* getParent() const;
 
 	void update(sf::Time dt, CommandQueue& commands);
 
+	// Hide the sf::Transformable setters so that local changes invalidate the cached world transforms
+	void setPosition(float x, float y);
+	void setPosition(const sf::Vector2f& position);
+	void setRotation(float angle);
+	void setScale(float factorX, float factorY);
+	void setScale(const sf::Vector2f& factors);
+	void setOrigin(float x, float y);
+	void setOrigin(const sf::Vector2f& origin);
+	void move(float offsetX, float offsetY);
+	void move(const sf::Vector2f& offset);
+	void rotate(float angle);
+	void scale(float factorX, float factorY);
+	void scale(const sf::Vector2f& factor);
+
 	sf::Vector2f getWorldPosition() const;
-	sf::Transform getWorldTransform() const;
+	const sf::Transform& getWorldTransform() const;
 
 	virtual sf::FloatRect	getBoundingRect() const;
+	virtual sf::Vector2f	getLastMovement() const;
+	virtual const CollisionShape* getCollisionShape() const;
+	virtual const sf::Sprite* getCollisionSprite() const;
 
-	void checkSceneCollision(SceneNode& sceneGraph, std::set<Pair>& collisionPairs);
-	void checkNodeCollision(SceneNode& node, std::set<Pair>& collisionPairs);
+	void collectCollidables(std::vector<SceneNode*>& collidables);
 
 	virtual unsigned int getCategory() const;
+	unsigned int getSerial() const;
 	void onCommand(const Command& command, sf::Time dt);
 	virtual bool isDestroyed() const;
 	virtual bool isMarkedForRemoval() const;
 
 	void removeWrecks();
+	void setCategoryRegistry(CategoryRegistry* registry);
+	void setFlatSceneGraph(FlatSceneGraph* graph);
+
+protected:
+	void invalidateWorldTransform();
 
 private:
 	virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
 	void updateChildren(sf::Time dt, CommandQueue& commands);
+	Ptr removeChild(std::size_t slot);
 
 	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
 	virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
 	void drawChildren(sf::RenderTarget& target, sf::RenderStates states) const;
 	void drawBoundingRect(sf::RenderTarget& target, sf::RenderStates states) const;
 
+	virtual sf::Transform getLocalTransform() const;
+	void registerSubtree(CategoryRegistry& registry);
+	void unregisterSubtree();
+	virtual void onRegistered(CategoryRegistry& registry);
+	virtual void onUnregistered();
+
 private:
 	std::vector<Ptr> mChildren;
 	SceneNode* mParent;
+	std::size_t mChildSlot;	// Index in the parent's mChildren
 	CategoryID mDefaultCategory;
+	unsigned int mSerial;
+
+	mutable sf::Transform mWorldTransform;
+	mutable bool mWorldTransformDirty;
+
+	CategoryRegistry* mRegistry;
+	std::size_t mRegistrySlot;
+	unsigned int mRegisteredCategory;
+
+	FlatSceneGraph* mFlatGraph;
+	std::size_t mFlatIndex;
+
+	friend class CategoryRegistry;
+	friend class FlatSceneGraph;
 };
 
 float	distance(const SceneNode& lhs, const SceneNode& rhs);
@@ -0,0 +1,26 @@
+#include "SteeringBatch.hpp"
+
+SteeringBatch::SteeringBatch(FrameArena& arena)
+	: components(ArenaAllocator<std::size_t>(arena))
+	, velocitiesX(ArenaAllocator<float>(arena))
+	, velocitiesY(ArenaAllocator<float>(arena))
+	, turnsX(ArenaAllocator<float>(arena))
+	, turnsY(ArenaAllocator<float>(arena))
+	, speeds(ArenaAllocator<float>(arena))
+{
+}
+
+void SteeringBatch::push(std::size_t component, sf::Vector2f velocity, sf::Vector2f turn, float speed)
+{
+	components.push_back(component);
+	velocitiesX.push_back(velocity.x);
+	velocitiesY.push_back(velocity.y);
+	turnsX.push_back(turn.x);
+	turnsY.push_back(turn.y);
+	speeds.push_back(speed);
+}
+
+std::size_t SteeringBatch::size() const
+{
+	return components.size();
+}
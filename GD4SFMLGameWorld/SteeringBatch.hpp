@@ -0,0 +1,24 @@
+#pragma once
+#include "ArenaAllocator.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cstddef>
+
+// Velocities of the steered entities for one tick, gathered entity by entity and written to the
+// EntityTable in one pass by EntityTable::steer(). Entry i of every array is for the entity at components[i].
+struct SteeringBatch
+{
+	explicit SteeringBatch(FrameArena& arena);
+
+	// Entities with a speed are turned by the given offset and moved at that speed, the others keep the velocity
+	void push(std::size_t component, sf::Vector2f velocity, sf::Vector2f turn, float speed);
+	std::size_t size() const;
+
+	FrameVector<std::size_t> components;
+	FrameVector<float> velocitiesX;
+	FrameVector<float> velocitiesY;
+	FrameVector<float> turnsX;
+	FrameVector<float> turnsY;
+	FrameVector<float> speeds;
+};
@@ -0,0 +1,165 @@
+#include "SweepAndPrune.hpp"
+
+#include <algorithm>
+
+namespace
+{
+	const std::size_t NoCollider = static_cast<std::size_t>(-1);
+
+	// Touching boxes do not overlap, so a max endpoint sorts before a min endpoint of the same value
+	template<typename Endpoint>
+	bool sortsBefore(const Endpoint& lhs, const Endpoint& rhs)
+	{
+		return lhs.value < rhs.value || (lhs.value == rhs.value && lhs.isMax && !rhs.isMax);
+	}
+}
+
+SweepAndPrune::SweepAndPrune(const CollisionMatrix& matrix)
+	: Broadphase(matrix)
+	, mProxies()
+	, mFreeProxies()
+	, mProxyLookup()
+	, mNewColliders()
+	, mEndpoints()
+	, mSortedEndpoints(0)
+	, mActive()
+	, mActiveBoxes()
+{
+}
+
+void SweepAndPrune::rebuild()
+{
+	for (Proxy& proxy : mProxies)
+		proxy.collider = NoCollider;
+
+	// Match this tick's colliders with the proxies kept from the last tick
+	mNewColliders.clear();
+	for (std::size_t i = 0; i < mColliders.size(); ++i)
+	{
+		auto found = mProxyLookup.find(mColliders[i].node->getSerial());
+		if (found != mProxyLookup.end())
+			mProxies[found->second].collider = i;
+		else
+			mNewColliders.push_back(i);
+	}
+
+	// Drop the nodes that are gone before reusing their proxies for newcomers
+	removeStaleProxies();
+	mSortedEndpoints = mEndpoints.size();
+	for (std::size_t collider : mNewColliders)
+		addProxy(collider);
+
+	for (Endpoint& endpoint : mEndpoints)
+	{
+		const sf::FloatRect& bounds = mColliders[mProxies[endpoint.proxy].collider].bounds;
+		endpoint.value = endpoint.isMax ? bounds.top + bounds.height : bounds.top;
+	}
+
+	sortEndpoints();
+}
+
+void SweepAndPrune::findPairs(std::vector<IndexPair>& indexPairs)
+{
+	// Sweep down the y axis, every box still open when another one starts overlaps it vertically
+	mActive.clear();
+	mActiveBoxes.clear();
+	for (const Endpoint& endpoint : mEndpoints)
+	{
+		Proxy& proxy = mProxies[endpoint.proxy];
+
+		if (endpoint.isMax)
+		{
+			std::size_t moved = mActive.back();
+			mActive[proxy.activeSlot] = moved;
+			mProxies[moved].activeSlot = proxy.activeSlot;
+			mActive.pop_back();
+			mActiveBoxes.swapRemove(proxy.activeSlot);
+			continue;
+		}
+
+		const Collider& collider = mColliders[proxy.collider];
+		mOverlaps.clear();
+		mActiveBoxes.findOverlaps(collider.bounds, 0, mActive.size(), mOverlaps);
+
+		for (std::size_t slot : mOverlaps)
+		{
+			std::size_t other = mProxies[mActive[slot]].collider;
+			if (mMatrix.interacts(mColliders[other].category, collider.category))
+				indexPairs.push_back(std::minmax(other, proxy.collider));
+		}
+
+		proxy.activeSlot = mActive.size();
+		mActive.push_back(endpoint.proxy);
+		mActiveBoxes.push(collider.bounds);
+	}
+}
+
+void SweepAndPrune::removeStaleProxies()
+{
+	bool removed = false;
+	for (std::size_t i = 0; i < mProxies.size(); ++i)
+	{
+		Proxy& proxy = mProxies[i];
+		if (proxy.inUse && proxy.collider == NoCollider)
+		{
+			mProxyLookup.erase(proxy.serial);
+			mFreeProxies.push_back(i);
+			proxy.inUse = false;
+			removed = true;
+		}
+	}
+
+	if (removed)
+	{
+		mEndpoints.erase(std::remove_if(mEndpoints.begin(), mEndpoints.end(), [this](const Endpoint& endpoint)
+		{
+			return !mProxies[endpoint.proxy].inUse;
+		}), mEndpoints.end());
+	}
+}
+
+void SweepAndPrune::addProxy(std::size_t collider)
+{
+	std::size_t index;
+	if (!mFreeProxies.empty())
+	{
+		index = mFreeProxies.back();
+		mFreeProxies.pop_back();
+	}
+	else
+	{
+		index = mProxies.size();
+		mProxies.push_back(Proxy());
+	}
+
+	Proxy& proxy = mProxies[index];
+	proxy.serial = mColliders[collider].node->getSerial();
+	proxy.collider = collider;
+	proxy.activeSlot = 0;
+	proxy.inUse = true;
+	mProxyLookup[proxy.serial] = index;
+
+	mEndpoints.push_back({ 0.f, index, false });
+	mEndpoints.push_back({ 0.f, index, true });
+}
+
+void SweepAndPrune::sortEndpoints()
+{
+	// A big batch of newcomers (e.g. the first tick) is cheaper to sort from scratch
+	if (mEndpoints.size() - mSortedEndpoints > mSortedEndpoints / 4)
+	{
+		std::sort(mEndpoints.begin(), mEndpoints.end(), sortsBefore<Endpoint>);
+		return;
+	}
+
+	// Insertion sort, each endpoint only travels as far as it moved past others since the last tick
+	for (std::size_t i = 1; i < mEndpoints.size(); ++i)
+	{
+		Endpoint endpoint = mEndpoints[i];
+		std::size_t j = i;
+		for (; j > 0 && sortsBefore(endpoint, mEndpoints[j - 1]); --j)
+			mEndpoints[j] = mEndpoints[j - 1];
+
+		mEndpoints[j] = endpoint;
+	}
+}
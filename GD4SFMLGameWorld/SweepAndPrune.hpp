@@ -0,0 +1,47 @@
+#pragma once
+#include "Broadphase.hpp"
+
+#include <vector>
+#include <unordered_map>
+
+// Sweep-and-prune broadphase along the y axis. Entities move a few pixels per tick,
+// so the endpoint list stays almost sorted and an insertion sort restores it in near-linear time.
+class SweepAndPrune : public Broadphase
+{
+public:
+	explicit SweepAndPrune(const CollisionMatrix& matrix);
+
+private:
+	virtual void rebuild();
+	virtual void findPairs(std::vector<IndexPair>& indexPairs);
+
+	void removeStaleProxies();
+	void addProxy(std::size_t collider);
+	void sortEndpoints();
+
+private:
+	struct Proxy
+	{
+		unsigned int serial;
+		std::size_t collider;
+		std::size_t activeSlot;
+		bool inUse;
+	};
+
+	struct Endpoint
+	{
+		float value;
+		std::size_t proxy;
+		bool isMax;
+	};
+
+	std::vector<Proxy> mProxies;
+	std::vector<std::size_t> mFreeProxies;
+	std::unordered_map<unsigned int, std::size_t> mProxyLookup;
+	std::vector<std::size_t> mNewColliders;
+
+	std::vector<Endpoint> mEndpoints;
+	std::size_t mSortedEndpoints;
+	std::vector<std::size_t> mActive;
+	AabbBatch mActiveBoxes;
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+//World systems, in the order they run each tick
+enum class SystemID
+{
+	DestroyOutsideView,
+	GuideMissiles,
+	GuideZombies,
+	SystemCount
+};
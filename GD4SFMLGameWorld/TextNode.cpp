@@ -3,6 +3,7 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 
 TextNode::TextNode(const FontHolder& fonts, const std::string& text)
+	: mUpright(false)
 {
 	mText.setFont(fonts.get(FontID::Main));
 	mText.setCharacterSize(20);
@@ -15,7 +16,19 @@ void TextNode::setString(const std::string& text)
 	centreOrigin(mText);
 }
 
+void TextNode::setUpright(bool upright)
+{
+	mUpright = upright;
+}
+
 void TextNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
 {
+	// Keep only the translation of the transform
+	if (mUpright)
+	{
+		const float* matrix = states.transform.getMatrix();
+		states.transform = sf::Transform(1.f, 0.f, matrix[12], 0.f, 1.f, matrix[13], 0.f, 0.f, 1.f);
+	}
+
 	target.draw(mText, states);
 }
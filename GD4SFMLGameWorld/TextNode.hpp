@@ -11,10 +11,13 @@ class TextNode : public SceneNode
 public:
 	explicit TextNode(const FontHolder& fonts, const std::string& text);
 	void setString(const std::string& text);
+	// Upright text stays where its parents put it, but does not turn with them (scaling is dropped as well)
+	void setUpright(bool upright);
 
 private:
 	virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
 
 private:
 	sf::Text mText;
+	bool mUpright;
 };
\ No newline at end of file
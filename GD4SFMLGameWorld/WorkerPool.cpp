@@ -0,0 +1,100 @@
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+
+WorkerPool::WorkerPool(std::size_t threadCount)
+	: mThreads()
+	, mMutex()
+	, mWakeUp()
+	, mFinished()
+	, mJob(nullptr)
+	, mTaskCount(0)
+	, mNextTask(0)
+	, mBusyThreads(0)
+	, mGeneration(0)
+	, mQuit(false)
+{
+	for (std::size_t i = 0; i < threadCount; ++i)
+		mThreads.push_back(std::thread(&WorkerPool::workerLoop, this, i + 1));
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mQuit = true;
+	}
+	mWakeUp.notify_all();
+
+	for (std::thread& thread : mThreads)
+		thread.join();
+}
+
+std::size_t WorkerPool::getWorkerCount() const
+{
+	return mThreads.size() + 1;
+}
+
+void WorkerPool::run(std::size_t taskCount, const Job& job)
+{
+	// Not worth waking anybody up
+	if (mThreads.empty() || taskCount <= 1)
+	{
+		for (std::size_t task = 0; task < taskCount; ++task)
+			job(task, 0);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mJob = &job;
+		mTaskCount = taskCount;
+		mNextTask = 0;
+		mBusyThreads = mThreads.size();
+		++mGeneration;
+	}
+	mWakeUp.notify_all();
+
+	work(0);
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	mFinished.wait(lock, [this] { return mBusyThreads == 0; });
+	mJob = nullptr;
+}
+
+std::size_t WorkerPool::getDefaultThreadCount()
+{
+	// Leave one core to the main thread, which works along anyway, and cap it for the few tasks a tick has
+	unsigned int cores = std::thread::hardware_concurrency();
+	return (cores > 1) ? std::min<std::size_t>(cores - 1, 7) : 0;
+}
+
+void WorkerPool::workerLoop(std::size_t worker)
+{
+	unsigned int generation = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWakeUp.wait(lock, [this, generation] { return mQuit || mGeneration != generation; });
+			if (mQuit)
+				return;
+
+			generation = mGeneration;
+		}
+
+		work(worker);
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (--mBusyThreads == 0)
+			mFinished.notify_one();
+	}
+}
+
+void WorkerPool::work(std::size_t worker)
+{
+	// Tasks are claimed one at a time, so uneven tasks balance out between the workers
+	for (std::size_t task = mNextTask++; task < mTaskCount; task = mNextTask++)
+		(*mJob)(task, worker);
+}
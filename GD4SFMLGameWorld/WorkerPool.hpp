@@ -0,0 +1,43 @@
+#pragma once
+#include <SFML/System/NonCopyable.hpp>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// Threads started once and kept waiting between ticks. run() splits a job into numbered tasks,
+// the calling thread takes part as worker 0 and returns when every task is done.
+class WorkerPool : private sf::NonCopyable
+{
+public:
+	typedef std::function<void(std::size_t task, std::size_t worker)> Job;
+
+public:
+	explicit WorkerPool(std::size_t threadCount = getDefaultThreadCount());
+	~WorkerPool();
+
+	std::size_t getWorkerCount() const;
+	void run(std::size_t taskCount, const Job& job);
+
+	static std::size_t getDefaultThreadCount();
+
+private:
+	void workerLoop(std::size_t worker);
+	void work(std::size_t worker);
+
+private:
+	std::vector<std::thread> mThreads;
+	std::mutex mMutex;
+	std::condition_variable mWakeUp;
+	std::condition_variable mFinished;
+
+	const Job* mJob;
+	std::size_t mTaskCount;
+	std::atomic<std::size_t> mNextTask;
+	std::size_t mBusyThreads;
+	unsigned int mGeneration;
+	bool mQuit;
+};
@@ -1,6 +1,12 @@
 #include "World.hpp"
 #include "ParticleID.hpp"
 #include "ParticleNode.hpp"
+#include "CollisionGrid.hpp"
+#include "SweepAndPrune.hpp"
+#include "DataTables.hpp"
+#include "EmitterNode.hpp"
+#include "AllocationCounter.hpp"
+#include "SteeringBatch.hpp"
 #include <iostream>
 
 #include <SFML/Graphics/RenderWindow.hpp>
@@ -11,23 +17,52 @@ World::World(sf::RenderTarget& outputTarget, FontHolder& fonts, SoundPlayer& sou
 	: mTarget(outputTarget)
 	, mSceneTexture()
 	, mCamera(outputTarget.getDefaultView())
+	, mTextures()
 	, mFonts(fonts)
 	, mSounds(sounds)
-	, mTextures()
+	, mEntities()
+	, mCategoryRegistry()
+	, mFlatSceneGraph()
 	, mSceneGraph()
 	, mSceneLayers()
+	, mFrameArena(16 * 1024)
+	, mCommandQueue()
+	, mCommandAllocations(0)
+	, mCollisionMatrix()
+	, mCollisionMasks()
+	, mWorkerPool()
+	, mBroadphase()
+	, mCollisionPairs()
+	, mSystems()
+	, mSystemClock()
 	, mWorldBounds(0.f, 0.f, mCamera.getSize().x, 5000.f)
 	, mSpawnPosition(mCamera.getSize().x / 2.f, mWorldBounds.height - mCamera.getSize().y / 2.f)
 	, mScrollSpeed(-50.f)
-	, mPlayerAircraft(nullptr)
-	, mPlayer2Aircraft(nullptr)
+	, mPlayerAircraft()
+	, mPlayer2Aircraft()
+	, mPlayerInput()
+	, mPlayer2Input()
 	, mEnemySpawnPoints()
-	, mActiveEnemies()
-	, mActivePlayers()
+	, mBloomEffect()
 {
+	mCollisionPairs.reserve(256);
+
+	// Size the entity pools for a busy level up front, so that gameplay only recycles their blocks
+	Projectile::getPool().reserve(512);
+	EmitterNode::getPool().reserve(128);
+	Pickup::getPool().reserve(64);
+	Aircraft::getPool().reserve(64);
+	Aircraft::getDeathStatePool().reserve(64);
+
 	mSceneTexture.create(mTarget.getSize().x, mTarget.getSize().y);
 	loadTextures();
+	buildCollisionMasks();
+	mSceneGraph.setCategoryRegistry(&mCategoryRegistry);
+	mSceneGraph.setFlatSceneGraph(&mFlatSceneGraph);
 	buildScene();
+	buildCollisionMatrix();
+	setBroadphase(BroadphaseID::UniformGrid);
+	registerSystems();
 
 	// Prepare the view
 	mCamera.setCenter(mSpawnPosition);
@@ -35,18 +70,39 @@ World::World(sf::RenderTarget& outputTarget, FontHolder& fonts, SoundPlayer& sou
 
 void World::update(sf::Time dt)
 {
-	// Scroll the world, reset player velocity
-	mCamera.move(0.f, mScrollSpeed * dt.asSeconds());
-	mPlayerAircraft->setVelocity(0.f, 0.f);
-	mPlayer2Aircraft->setVelocity(0.f, 0.f);
+	// Scratch memory of the last tick is no longer referenced
+	mFrameArena.reset();
 
-	// Setup commands to destroy entities, and guide missiles
-	destroyEntitiesOutsideView();
-	guideMissiles();
+	// Heap allocations of the command path: the whole section from player input to dispatch is counted here,
+	// pushes made elsewhere since the last tick (the scene update) are counted by the queue itself
+	std::size_t commandAllocations = getThreadAllocationCount();
+	std::size_t queueAllocations = mCommandQueue.getAllocationCount();
+
+	// Scroll the world, reset player velocity and steer the players with the input gathered since the last tick, once
+	mCamera.move(0.f, mScrollSpeed * dt.asSeconds());
+	if (Aircraft* player = getPlayerAircraft())
+	{
+		player->setVelocity(0.f, 0.f);
+		player->applyInput(mPlayerInput);
+	}
+	if (Aircraft* player2 = getPlayer2Aircraft())
+	{
+		player2->setVelocity(0.f, 0.f);
+		player2->applyInput(mPlayer2Input);
+	}
+	mPlayerInput = PlayerInput();
+	mPlayer2Input = PlayerInput();
 
-	// Forward commands to scene graph, adapt velocity (scrolling, diagonal correction)
+	// Forward this tick's batch of commands to the nodes of their categories, adapt velocity (scrolling, diagonal correction).
+	// Whatever gets pushed from here on (e.g. during the scene update) is dispatched next tick.
+	mCommandQueue.swapBuffers();
 	while (!mCommandQueue.isEmpty())
-		mSceneGraph.onCommand(mCommandQueue.pop(), dt);
+		mCategoryRegistry.dispatch(mCommandQueue.pop(), dt);
+	mCommandAllocations = queueAllocations + getThreadAllocationCount() - commandAllocations;
+	mCommandQueue.resetAllocationCount();
+
+	// Destroy entities outside the view, guide missiles...
+	runSystems(dt);
 	adaptPlayerVelocity();
 	adaptPlayer2Velocity();
 
@@ -54,13 +110,16 @@ void World::update(sf::Time dt)
 	handleCollisions();
 
 	// Remove all destroyed entities, create new ones
-	mSceneGraph.removeWrecks();
+	mEntities.removeWrecks();
 	spawnEnemies();
 
-	// Regular update step, adapt position (correct if outside view)
-	mSceneGraph.update(dt, mCommandQueue);
+	// Regular update step, move all entities at once, adapt position (correct if outside view), emit where the entities ended up
+	mFlatSceneGraph.update(dt, mCommandQueue);
+	steerEnemies(dt);
+	mEntities.integrate(dt);
 	adaptPlayerPosition();
 	adaptPlayer2Position();
+	emitParticles();
 
 	updateSounds();
 }
@@ -71,14 +130,14 @@ void World::draw()
 	{
 		mSceneTexture.clear();
 		mSceneTexture.setView(mCamera);
-		mSceneTexture.draw(mSceneGraph);
+		mSceneTexture.draw(mFlatSceneGraph);
 		mSceneTexture.display();
 		mBloomEffect.apply(mSceneTexture, mTarget);
 	}
 	else
 	{
 		mTarget.setView(mCamera);
-		mTarget.draw(mSceneGraph);
+		mTarget.draw(mFlatSceneGraph);
 	}
 }
 
@@ -87,26 +146,102 @@ CommandQueue& World::getCommandQueue()
 	return mCommandQueue;
 }
 
+std::size_t World::getCommandAllocations() const
+{
+	return mCommandAllocations;
+}
+
+const FrameArena& World::getFrameArena() const
+{
+	return mFrameArena;
+}
+
+std::size_t World::getEntityPoolAllocations() const
+{
+	// Stays constant while the pools have enough blocks for everything alive
+	return Projectile::getPool().getHeapAllocationCount()
+		+ EmitterNode::getPool().getHeapAllocationCount()
+		+ Pickup::getPool().getHeapAllocationCount()
+		+ Aircraft::getPool().getHeapAllocationCount()
+		+ Aircraft::getDeathStatePool().getHeapAllocationCount();
+}
+
+std::size_t World::getEntityPoolReuses() const
+{
+	return Projectile::getPool().getReuseCount()
+		+ EmitterNode::getPool().getReuseCount()
+		+ Pickup::getPool().getReuseCount()
+		+ Aircraft::getPool().getReuseCount()
+		+ Aircraft::getDeathStatePool().getReuseCount();
+}
+
+void World::setPlayerInput(const PlayerInput& input)
+{
+	mPlayerInput = input;
+}
+
+void World::setPlayer2Input(const PlayerInput& input)
+{
+	mPlayer2Input = input;
+}
+
+Aircraft* World::getPlayerAircraft() const
+{
+	// Null once the aircraft has been removed from the scene
+	return mEntities.get<Aircraft>(mPlayerAircraft);
+}
+
+Aircraft* World::getPlayer2Aircraft() const
+{
+	return mEntities.get<Aircraft>(mPlayer2Aircraft);
+}
+
 bool World::hasAlivePlayer() const
 {
-	return !mPlayerAircraft->isMarkedForRemoval() && !mPlayer2Aircraft->isMarkedForRemoval();
+	const Aircraft* player = getPlayerAircraft();
+	const Aircraft* player2 = getPlayer2Aircraft();
+	return player && !player->isMarkedForRemoval() && player2 && !player2->isMarkedForRemoval();
 }
 
 bool World::hasPlayerReachedEnd() const
 {
-	return !mWorldBounds.contains(mPlayerAircraft->getPosition()) && !mWorldBounds.contains(mPlayer2Aircraft->getPosition());
+	const Aircraft* player = getPlayerAircraft();
+	const Aircraft* player2 = getPlayer2Aircraft();
+	return player && player2 && !mWorldBounds.contains(player->getPosition()) && !mWorldBounds.contains(player2->getPosition());
 }
 
 void World::updateSounds()
 {
 	//Set the listener to the player position
-	mSounds.setListenPosition(mPlayerAircraft->getWorldPosition());
-	mSounds.setListenPosition(mPlayer2Aircraft->getWorldPosition());
+	if (const Aircraft* player = getPlayerAircraft())
+		mSounds.setListenPosition(player->getWorldPosition());
+	if (const Aircraft* player2 = getPlayer2Aircraft())
+		mSounds.setListenPosition(player2->getWorldPosition());
 	//Remove unused sounds
 	mSounds.removeStoppedSounds();
 
 }
 
+void World::setBroadphase(BroadphaseID type)
+{
+	switch (type)
+	{
+	case BroadphaseID::BruteForce:
+		mBroadphase.reset(new Broadphase(mCollisionMatrix));
+		break;
+
+	case BroadphaseID::UniformGrid:
+		mBroadphase.reset(new CollisionGrid(mCollisionMatrix, &mWorkerPool));
+		break;
+
+	case BroadphaseID::SweepAndPrune:
+		mBroadphase.reset(new SweepAndPrune(mCollisionMatrix));
+		break;
+	}
+
+	mBroadphase->setCollisionMasks(&mCollisionMasks);
+}
+
 void World::loadTextures()
 {
 	mTextures.load(TextureID::Entities, "Media/Textures/Entities.png");
@@ -116,88 +251,85 @@ void World::loadTextures()
 	mTextures.load(TextureID::FinishLine, "Media/Textures/FinishLine.png");
 }
 
-bool matchesCategories(SceneNode::Pair& colliders, CategoryID type1, CategoryID type2)
+void World::buildCollisionMatrix()
 {
-	unsigned int category1 = colliders.first->getCategory();
-	unsigned int category2 = colliders.second->getCategory();
-
-	// Make sure first pair entry has category type1 and second has type2
-	if (((static_cast<int>(type1))& category1) && ((static_cast<int>(type2))& category2))
+	// Collision: Player damage = enemy's remaining HP
+	auto crash = [](Aircraft& player, Aircraft& enemy)
 	{
-		return true;
-	}
-	else if (((static_cast<int>(type1))& category2) && ((static_cast<int>(type2))& category1))
+		player.damage(enemy.getHitpoints());
+		enemy.destroy();
+	};
+
+	// Apply pickup effect to player, destroy projectile
+	auto collect = [this](Aircraft& player, Pickup& pickup)
 	{
-		std::swap(colliders.first, colliders.second);
-		return true;
-	}
-	else
+		pickup.apply(player);
+		player.playerLocalSound(mCommandQueue, SoundEffectID::CollectPickup);
+		pickup.destroy();
+	};
+
+	// Apply projectile damage to aircraft, destroy projectile
+	auto hit = [](Aircraft& aircraft, Projectile& projectile)
 	{
-		return false;
-	}
+		aircraft.damage(projectile.getDamage());
+		projectile.destroy();
+	};
+
+	mCollisionMatrix.addRule<Aircraft, Aircraft>(CategoryID::PlayerAircraft, CategoryID::EnemyAircraft, crash);
+	mCollisionMatrix.addRule<Aircraft, Aircraft>(CategoryID::Player2Aircraft, CategoryID::EnemyAircraft, crash);
+	mCollisionMatrix.addEnterRule<Aircraft, Pickup>(CategoryID::PlayerAircraft, CategoryID::Pickup, collect);
+	mCollisionMatrix.addEnterRule<Aircraft, Pickup>(CategoryID::Player2Aircraft, CategoryID::Pickup, collect);
+	mCollisionMatrix.addRule<Aircraft, Projectile>(CategoryID::EnemyAircraft, CategoryID::AlliedProjectile, hit);
+	mCollisionMatrix.addRule<Aircraft, Projectile>(CategoryID::PlayerAircraft, CategoryID::EnemyProjectile, hit);
+	mCollisionMatrix.addRule<Aircraft, Projectile>(CategoryID::Player2Aircraft, CategoryID::EnemyProjectile, hit);
 }
 
 void World::handleCollisions()
 {
-	std::set<SceneNode::Pair> collisionPairs;
-	mSceneGraph.checkSceneCollision(mSceneGraph, collisionPairs);
-
-	for (SceneNode::Pair pair : collisionPairs)
-	{
-		if (matchesCategories(pair, CategoryID::PlayerAircraft, CategoryID::EnemyAircraft))
-		{
-			auto& player = static_cast<Aircraft&>(*pair.first);
-			auto& enemy = static_cast<Aircraft&>(*pair.second);
+	// Reuse the pair buffer from last tick, the broadphase hands out every pair once and in a fixed order
+	mCollisionPairs.clear();
+	mBroadphase->update(mSceneGraph);
+	mBroadphase->checkCollisions(mCollisionPairs);
 
-			// Collision: Player damage = enemy's remaining HP
-			player.damage(enemy.getHitpoints());
-			enemy.destroy();
-		}
-
-		else if (matchesCategories(pair, CategoryID::Player2Aircraft, CategoryID::EnemyAircraft))
-		{
-			auto& player2 = static_cast<Aircraft&>(*pair.first);
-			auto& enemy = static_cast<Aircraft&>(*pair.second);
+	// Each pair goes straight to the response registered for its categories
+	for (const SceneNode::Pair& pair : mCollisionPairs)
+		mCollisionMatrix.dispatch(pair);
 
-			//Collision: Player damage = enemy's remaining HP
-			player2.damage(enemy.getHitpoints());
-			enemy.destroy();
-		}
+	// Responses that only happen once per touch (collecting a pickup) wait for the contact to begin
+	for (const Broadphase::Contact& contact : mBroadphase->getContacts())
+	{
+		if (contact.type == ContactID::Enter)
+			mCollisionMatrix.dispatchEnter(contact.pair);
+	}
+}
 
-		else if (matchesCategories(pair, CategoryID::PlayerAircraft, CategoryID::Pickup))
-		{
-			auto& player = static_cast<Aircraft&>(*pair.first);
-			auto& pickup = static_cast<Pickup&>(*pair.second);
+void World::buildCollisionMasks()
+{
+	// All entity sprites are cut from the Entities sheet, read its pixels back once and mask every rect up front
+	const sf::Texture& texture = mTextures.get(TextureID::Entities);
+	const sf::Image image = texture.copyToImage();
 
-			// Apply pickup effect to player, destroy projectile
-			pickup.apply(player);
-			player.playerLocalSound(mCommandQueue, SoundEffectID::CollectPickup);
-			pickup.destroy();
-		}
+	for (const AircraftData& data : initializeAircraftData())
+	{
+		mCollisionMasks.build(texture, image, data.textureRect);
 
-		else if (matchesCategories(pair, CategoryID::Player2Aircraft, CategoryID::Pickup))
+		// The roll animation uses the next two frames along the row
+		if (data.hasRollAnimation)
 		{
-			auto& player2 = static_cast<Aircraft&>(*pair.first);
-			auto& pickup = static_cast<Pickup&>(*pair.second);
-
-			// Apply pickup effect to player, destroy projectile
-			pickup.apply(player2);
-			player2.playerLocalSound(mCommandQueue, SoundEffectID::CollectPickup);
-			pickup.destroy();
+			sf::IntRect textureRect = data.textureRect;
+			for (int frame = 1; frame <= 2; ++frame)
+			{
+				textureRect.left += data.textureRect.width;
+				mCollisionMasks.build(texture, image, textureRect);
+			}
 		}
+	}
 
-		else if (matchesCategories(pair, CategoryID::EnemyAircraft, CategoryID::AlliedProjectile)
-			|| matchesCategories(pair, CategoryID::PlayerAircraft, CategoryID::EnemyProjectile)
-			|| matchesCategories(pair, CategoryID::Player2Aircraft, CategoryID::EnemyProjectile))
-		{
-			auto& aircraft = static_cast<Aircraft&>(*pair.first);
-			auto& projectile = static_cast<Projectile&>(*pair.second);
+	for (const ProjectileData& data : initializeProjectileData())
+		mCollisionMasks.build(texture, image, data.textureRect);
 
-			// Apply projectile damage to aircraft, destroy projectile
-			aircraft.damage(projectile.getDamage());
-			projectile.destroy();
-		}
-	}
+	for (const PickupData& data : initializePickupData())
+		mCollisionMasks.build(texture, image, data.textureRect);
 }
 
 void World::buildScene()
@@ -230,11 +362,13 @@ void World::buildScene()
 	finishSprite->setPosition(0.f, -76.f);
 	mSceneLayers[static_cast<int>(LayerID::Background)]->attachChild(std::move(finishSprite));
 
-	//Add particle nodes for smoke and propellant
+	//Add particle nodes for smoke and propellant, and register them for the emitters to bind to
 	std::unique_ptr<ParticleNode> smokeNode(new ParticleNode(ParticleID::Smoke, mTextures));
+	mCategoryRegistry.addParticleSystem(*smokeNode);
 	mSceneLayers[static_cast<int>(LayerID::LowerAir)]->attachChild(std::move(smokeNode));
 
 	std::unique_ptr<ParticleNode> propellantNode(new ParticleNode(ParticleID::Propellant, mTextures));
+	mCategoryRegistry.addParticleSystem(*propellantNode);
 	mSceneLayers[static_cast<int>(LayerID::LowerAir)]->attachChild(std::move(propellantNode));
 
 	//Add the sound effect node
@@ -242,14 +376,14 @@ void World::buildScene()
 	mSceneGraph.attachChild(std::move(soundNode));
 
 	// Add player's aircraft
-	std::unique_ptr<Aircraft> player1(new Aircraft(PersonID::Player, mTextures, mFonts));
-	mPlayerAircraft = player1.get();
-	mPlayerAircraft->setPosition(mSpawnPosition);
+	std::unique_ptr<Aircraft> player1 = mEntities.create<Aircraft>(PersonID::Player, mTextures, mFonts);
+	mPlayerAircraft = player1->getHandle();
+	player1->setPosition(mSpawnPosition);
 	mSceneLayers[static_cast<int>(LayerID::UpperAir)]->attachChild(std::move(player1));
 
-	std::unique_ptr<Aircraft> player2(new Aircraft(PersonID::Player2, mTextures, mFonts));
-	mPlayer2Aircraft = player2.get();
-	mPlayer2Aircraft->setPosition(mSpawnPosition.x + 100, mSpawnPosition.y);
+	std::unique_ptr<Aircraft> player2 = mEntities.create<Aircraft>(PersonID::Player2, mTextures, mFonts);
+	mPlayer2Aircraft = player2->getHandle();
+	player2->setPosition(mSpawnPosition.x + 100, mSpawnPosition.y);
 	mSceneLayers[static_cast<int>(LayerID::UpperAir)]->attachChild(std::move(player2));
 
 	addEnemies();
@@ -261,34 +395,44 @@ void World::adaptPlayerPosition()
 	sf::FloatRect viewBounds = getViewBounds();
 	const float borderDistance = 40.f;
 
-	sf::Vector2f position = mPlayerAircraft->getPosition();
-	position.x = std::max(position.x, viewBounds.left + borderDistance);
-	position.x = std::min(position.x, viewBounds.left + viewBounds.width - borderDistance);
-	position.y = std::max(position.y, viewBounds.top + borderDistance);
-	position.y = std::min(position.y, viewBounds.top + viewBounds.height - borderDistance);
-	mPlayerAircraft->setPosition(position);
+	if (Aircraft* player = getPlayerAircraft())
+	{
+		sf::Vector2f position = player->getPosition();
+		position.x = std::max(position.x, viewBounds.left + borderDistance);
+		position.x = std::min(position.x, viewBounds.left + viewBounds.width - borderDistance);
+		position.y = std::max(position.y, viewBounds.top + borderDistance);
+		position.y = std::min(position.y, viewBounds.top + viewBounds.height - borderDistance);
+		player->setPosition(position);
+	}
 
-	sf::Vector2f position2 = mPlayer2Aircraft->getPosition();
-	position2.x = std::max(position2.x, viewBounds.left + borderDistance);
-	position2.x = std::min(position2.x, viewBounds.left + viewBounds.width - borderDistance);
-	position2.y = std::max(position2.y, viewBounds.top + borderDistance);
-	position2.y = std::min(position2.y, viewBounds.top + viewBounds.height - borderDistance);
-	mPlayer2Aircraft->setPosition(position2);
+	if (Aircraft* player2 = getPlayer2Aircraft())
+	{
+		sf::Vector2f position2 = player2->getPosition();
+		position2.x = std::max(position2.x, viewBounds.left + borderDistance);
+		position2.x = std::min(position2.x, viewBounds.left + viewBounds.width - borderDistance);
+		position2.y = std::max(position2.y, viewBounds.top + borderDistance);
+		position2.y = std::min(position2.y, viewBounds.top + viewBounds.height - borderDistance);
+		player2->setPosition(position2);
+	}
 }
 
 void World::adaptPlayerVelocity()
 {
-	sf::Vector2f velocity = mPlayerAircraft->getVelocity();
+	Aircraft* player = getPlayerAircraft();
+	if (!player)
+		return;
+
+	sf::Vector2f velocity = player->getVelocity();
 	
 
 	// If moving diagonally, reduce velocity (to have always same velocity)
 	if (velocity.x != 0.f && velocity.y != 0.f)
-		mPlayerAircraft->setVelocity(velocity / std::sqrt(2.f));
+		player->setVelocity(velocity / std::sqrt(2.f));
 
 	
 
 	// Add scrolling velocity
-	mPlayerAircraft->accelerate(0.f, mScrollSpeed);
+	player->accelerate(0.f, mScrollSpeed);
 }
 
 void World::adaptPlayer2Position()
@@ -296,27 +440,33 @@ void World::adaptPlayer2Position()
 	// Keep player's position inside the screen bounds, at least borderDistance units from the border
 	sf::FloatRect viewBounds = getViewBounds();
 	const float borderDistance = 40.f;
+	Aircraft* player2 = getPlayer2Aircraft();
+	if (!player2)
+		return;
 
-
-	sf::Vector2f position2 = mPlayer2Aircraft->getPosition();
+	sf::Vector2f position2 = player2->getPosition();
 	position2.x = std::max(position2.x, viewBounds.left + borderDistance);
 	position2.x = std::min(position2.x, viewBounds.left + viewBounds.width - borderDistance);
 	position2.y = std::max(position2.y, viewBounds.top + borderDistance);
 	position2.y = std::min(position2.y, viewBounds.top + viewBounds.height - borderDistance);
-	mPlayer2Aircraft->setPosition(position2);
+	player2->setPosition(position2);
 }
 
 void World::adaptPlayer2Velocity()
 {
-	sf::Vector2f velocity2 = mPlayer2Aircraft->getVelocity();
+	Aircraft* player2 = getPlayer2Aircraft();
+	if (!player2)
+		return;
+
+	sf::Vector2f velocity2 = player2->getVelocity();
 
 	// If moving diagonally, reduce velocity (to have always same velocity)
 
 	if (velocity2.x != 0.f && velocity2.y != 0.f)
-		mPlayer2Aircraft->setVelocity(velocity2 / std::sqrt(2.f));
+		player2->setVelocity(velocity2 / std::sqrt(2.f));
 
 	// Add scrolling velocity
-	mPlayer2Aircraft->accelerate(0.f, mScrollSpeed);
+	player2->accelerate(0.f, mScrollSpeed);
 }
 
 void World::addEnemies()
@@ -404,112 +554,158 @@ void World::spawnEnemies()
 	{
 		SpawnPoint spawn = mEnemySpawnPoints.back();
 
-		std::unique_ptr<Aircraft> enemy(new Aircraft(spawn.type, mTextures, mFonts));
+		std::unique_ptr<Aircraft> enemy = mEntities.create<Aircraft>(spawn.type, mTextures, mFonts);
 		enemy->setPosition(spawn.x, spawn.y);
-		enemy->setRotation(180.f);
+		enemy->setHeading(sf::Vector2f(0.f, 1.f));
 
 		mSceneLayers[static_cast<int>(LayerID::UpperAir)]->attachChild(std::move(enemy));
 
 		// Enemy is spawned, remove from the list to spawn
 		mEnemySpawnPoints.pop_back();
 	}
+}
 
-	/*Command playerCollector;
-	playerCollector.category = static_cast<int>(CategoryID::PlayerAircraft);
-	playerCollector.action = derivedAction<Aircraft>([this](Aircraft& player, sf::Time)
-		{
-			if (!player.isDestroyed())
-				mActivePlayers.push_back(&player);
-		});
+void World::registerSystems()
+{
+	auto registerSystem = [this](SystemID id, const char* name, SystemFunction function, bool enabled)
+	{
+		mSystems[static_cast<int>(id)] = { name, function, enabled, sf::Time::Zero };
+	};
 
-	Command zombieGuider;
-	zombieGuider.category = static_cast<int>(CategoryID::EnemyAircraft);
-	zombieGuider.action = derivedAction<Aircraft>([this](Aircraft& zombie, sf::Time)
-		{
-			if (!zombie.isGuided())
-				return;
+	registerSystem(SystemID::DestroyOutsideView, "Destroy outside view", &World::destroyEntitiesOutsideView, true);
+	registerSystem(SystemID::GuideMissiles, "Guide missiles", &World::guideMissiles, true);
 
-			float minDistance = std::numeric_limits<float>::max();
-			Aircraft* closestPlayer = nullptr;
+	// Zombies homing in on the players used to be commented out, it stays off until enabled
+	registerSystem(SystemID::GuideZombies, "Guide zombies", &World::guideZombies, false);
+}
 
-			for (Aircraft* player : mActivePlayers)
-			{
-				float playerDistance = distance(zombie, *player);
+void World::runSystems(sf::Time dt)
+{
+	for (System& system : mSystems)
+	{
+		system.elapsed = sf::Time::Zero;
+		if (!system.enabled)
+			continue;
 
-				if (playerDistance < minDistance)
-				{
-					closestPlayer = player;
-					minDistance = playerDistance;
-				}
-			}
+		mSystemClock.restart();
+		(this->*system.function)(dt);
+		system.elapsed = mSystemClock.getElapsedTime();
+	}
+}
 
-			if (closestPlayer)
-				zombie.guideTowards(closestPlayer->getWorldPosition());
-		});
+void World::setSystemEnabled(SystemID system, bool enabled)
+{
+	mSystems[static_cast<int>(system)].enabled = enabled;
+}
 
-	mCommandQueue.push(playerCollector);
-	mCommandQueue.push(zombieGuider);
-	mActivePlayers.clear();*/
+sf::Time World::getSystemTime(SystemID system) const
+{
+	return mSystems[static_cast<int>(system)].elapsed;
 }
 
-void World::destroyEntitiesOutsideView()
+void World::destroyEntitiesOutsideView(sf::Time)
 {
-	Command command;
-	command.category = static_cast<int>(CategoryID::Projectile) | static_cast<int>(CategoryID::EnemyAircraft);
-	command.action = derivedAction<Entity>([this](Entity& e, sf::Time)
+	sf::FloatRect battlefieldBounds = getBattlefieldBounds();
+	mCategoryRegistry.forEach<Entity>(static_cast<int>(CategoryID::Projectile) | static_cast<int>(CategoryID::EnemyAircraft), [&battlefieldBounds](Entity& e)
 	{
-		if (!getBattlefieldBounds().intersects(e.getBoundingRect()))
+		if (!battlefieldBounds.intersects(e.getBoundingRect()))
 			e.destroy();
 	});
-
-	mCommandQueue.push(command);
 }
 
-void World::guideMissiles()
+void World::guideMissiles(sf::Time)
 {
-	// Setup command that stores all enemies in mActiveEnemies
-	Command enemyCollector;
-	enemyCollector.category = static_cast<int>(CategoryID::EnemyAircraft);
-	enemyCollector.action = derivedAction<Aircraft>([this](Aircraft& enemy, sf::Time)
+	// Collect all enemies in this tick's scratch memory
+	FrameVector<Aircraft*> activeEnemies{ ArenaAllocator<Aircraft*>(mFrameArena) };
+	activeEnemies.reserve(mCategoryRegistry.getNodes(CategoryID::EnemyAircraft).size());
+	mCategoryRegistry.forEach<Aircraft>(static_cast<int>(CategoryID::EnemyAircraft), [&activeEnemies](Aircraft& enemy)
 	{
 		if (!enemy.isDestroyed())
-			mActiveEnemies.push_back(&enemy);
+			activeEnemies.push_back(&enemy);
 	});
 
-	
-
-	// Setup command that guides all missiles to the enemy which is currently closest to the player
-	Command missileGuider;
-	missileGuider.category = static_cast<int>(CategoryID::AlliedProjectile);
-	missileGuider.action = derivedAction<Projectile>([this](Projectile& missile, sf::Time)
+	// Guide all missiles to the enemy which is currently closest to them
+	mCategoryRegistry.forEach<Projectile>(static_cast<int>(CategoryID::AlliedProjectile), [&activeEnemies](Projectile& missile)
 	{
 		// Ignore unguided bullets
 		if (!missile.isGuided())
 			return;
 
-		float minDistance = std::numeric_limits<float>::max();
-		Aircraft* closestEnemy = nullptr;
+		Aircraft* closestEnemy = findClosest(missile, activeEnemies);
+		if (closestEnemy)
+			missile.guideTowards(closestEnemy->getWorldPosition());
+	});
+}
 
-		// Find closest enemy
-		for (Aircraft* enemy : mActiveEnemies)
-		{
-			float enemyDistance = distance(missile, *enemy);
+void World::guideZombies(sf::Time)
+{
+	// Collect all players in this tick's scratch memory
+	FrameVector<Aircraft*> activePlayers{ ArenaAllocator<Aircraft*>(mFrameArena) };
+	mCategoryRegistry.forEach<Aircraft>(static_cast<int>(CategoryID::PlayerAircraft) | static_cast<int>(CategoryID::Player2Aircraft), [&activePlayers](Aircraft& player)
+	{
+		if (!player.isDestroyed())
+			activePlayers.push_back(&player);
+	});
 
-			if (enemyDistance < minDistance)
-			{
-				closestEnemy = enemy;
-				minDistance = enemyDistance;
-			}
-		}
+	// Guide all zombies to the player which is currently closest to them
+	mCategoryRegistry.forEach<Aircraft>(static_cast<int>(CategoryID::EnemyAircraft), [&activePlayers](Aircraft& zombie)
+	{
+		if (!zombie.isGuided())
+			return;
 
-		if (closestEnemy)
-			missile.guideTowards(closestEnemy->getWorldPosition());
+		Aircraft* closestPlayer = findClosest(zombie, activePlayers);
+		if (closestPlayer)
+			zombie.guideTowards(closestPlayer->getWorldPosition());
+	});
+}
+
+void World::steerEnemies(sf::Time dt)
+{
+	// Movement patterns first, guided enemies then turn away from the pattern's velocity towards their target.
+	// The velocities are written to the table in one pass, only the guided enemies are visited again to face them.
+	SteeringBatch batch(mFrameArena);
+	FrameVector<Aircraft*> guided{ ArenaAllocator<Aircraft*>(mFrameArena) };
+	mCategoryRegistry.forEach<Aircraft>(static_cast<int>(CategoryID::EnemyAircraft), [&batch, &guided, dt](Aircraft& enemy)
+	{
+		if (enemy.isDestroyed())
+			return;
+
+		enemy.pushSteering(batch, dt);
+		if (enemy.isGuided())
+			guided.push_back(&enemy);
 	});
 
-	// Push commands, reset active enemies
-	mCommandQueue.push(enemyCollector);
-	mCommandQueue.push(missileGuider);
-	mActiveEnemies.clear();
+	mEntities.steer(batch);
+	for (Aircraft* enemy : guided)
+		enemy->faceVelocity();
+}
+
+void World::emitParticles()
+{
+	// Emitters follow entities, which only reach this tick's position in EntityTable::integrate()
+	mCategoryRegistry.forEach<EmitterNode>([](EmitterNode& emitter)
+	{
+		emitter.emitParticles();
+	});
+}
+
+Aircraft* World::findClosest(const SceneNode& node, const FrameVector<Aircraft*>& candidates)
+{
+	float minDistance = std::numeric_limits<float>::max();
+	Aircraft* closest = nullptr;
+
+	for (Aircraft* candidate : candidates)
+	{
+		float candidateDistance = distance(node, *candidate);
+
+		if (candidateDistance < minDistance)
+		{
+			closest = candidate;
+			minDistance = candidateDistance;
+		}
+	}
+
+	return closest;
 }
 
 sf::FloatRect World::getViewBounds() const
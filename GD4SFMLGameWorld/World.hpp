@@ -13,10 +13,22 @@
 #include "BloomEffect.hpp"
 #include "SoundNode.hpp"
 #include "SoundPlayer.hpp"
+#include "CollisionMatrix.hpp"
+#include "CollisionMaskSet.hpp"
+#include "Broadphase.hpp"
+#include "BroadphaseID.hpp"
+#include "WorkerPool.hpp"
+#include "CategoryRegistry.hpp"
+#include "FlatSceneGraph.hpp"
+#include "EntityTable.hpp"
+#include "SystemID.hpp"
+#include "FrameArena.hpp"
+#include "ArenaAllocator.hpp"
 
 #include "SFML/System/NonCopyable.hpp"
 #include "SFML/Graphics/View.hpp"
 #include "SFML/Graphics/Texture.hpp"
+#include "SFML/System/Clock.hpp"
 
 #include <array>
 
@@ -35,17 +47,30 @@ public:
 	void update(sf::Time dt);
 	void draw();
 	CommandQueue& getCommandQueue();
+	std::size_t getCommandAllocations() const;
+	std::size_t getEntityPoolAllocations() const;
+	std::size_t getEntityPoolReuses() const;
+	const FrameArena& getFrameArena() const;
+	void setPlayerInput(const PlayerInput& input);
+	void setPlayer2Input(const PlayerInput& input);
+	void setSystemEnabled(SystemID system, bool enabled);
+	sf::Time getSystemTime(SystemID system) const;
 	bool hasAlivePlayer() const;
 	bool hasPlayerReachedEnd() const;
 	void updateSounds();
+	void setBroadphase(BroadphaseID type);
 
 private:
 	void loadTextures();
+	Aircraft* getPlayerAircraft() const;
+	Aircraft* getPlayer2Aircraft() const;
+	void buildCollisionMasks();
 	void buildScene();
 	void adaptPlayerPosition();
 	void adaptPlayer2Position();
 	void adaptPlayerVelocity();
 	void adaptPlayer2Velocity();
+	void buildCollisionMatrix();
 	void handleCollisions();
 
 	void spawnEnemies();
@@ -55,9 +80,14 @@ private:
 	sf::FloatRect getBattlefieldBounds() const;
 	sf::FloatRect getViewBounds() const;
 
-	void destroyEntitiesOutsideView();
-
-	void guideMissiles();
+	void registerSystems();
+	void runSystems(sf::Time dt);
+	void destroyEntitiesOutsideView(sf::Time dt);
+	void guideMissiles(sf::Time dt);
+	void guideZombies(sf::Time dt);
+	void steerEnemies(sf::Time dt);
+	void emitParticles();
+	static Aircraft* findClosest(const SceneNode& node, const FrameVector<Aircraft*>& candidates);
 
 	struct SpawnPoint
 	{
@@ -73,6 +103,16 @@ private:
 		float y;
 	};
 
+	typedef void (World::*SystemFunction)(sf::Time dt);
+
+	struct System
+	{
+		const char* name;
+		SystemFunction function;
+		bool enabled;
+		sf::Time elapsed;	// Time spent in the system during the last tick
+	};
+
 private:
 	sf::RenderTarget& mTarget;
 	sf::RenderTexture mSceneTexture;
@@ -81,19 +121,31 @@ private:
 	FontHolder& mFonts;
 	SoundPlayer& mSounds;
 
+	EntityTable mEntities;
+	CategoryRegistry mCategoryRegistry;
+	FlatSceneGraph mFlatSceneGraph;
 	SceneNode mSceneGraph;
 	std::array<SceneNode*, static_cast<int>(LayerID::LayerCount)> mSceneLayers;
+	FrameArena mFrameArena;
 	CommandQueue mCommandQueue;
+	std::size_t mCommandAllocations;
+	CollisionMatrix mCollisionMatrix;
+	CollisionMaskSet mCollisionMasks;
+	WorkerPool mWorkerPool;
+	Broadphase::Ptr mBroadphase;
+	std::vector<SceneNode::Pair> mCollisionPairs;
+	std::array<System, static_cast<int>(SystemID::SystemCount)> mSystems;
+	sf::Clock mSystemClock;
 
 	sf::FloatRect mWorldBounds;
 	sf::Vector2f mSpawnPosition;
 	float mScrollSpeed;
-	Aircraft* mPlayerAircraft;
-	Aircraft* mPlayer2Aircraft;
+	EntityHandle mPlayerAircraft;
+	EntityHandle mPlayer2Aircraft;
+	PlayerInput mPlayerInput;
+	PlayerInput mPlayer2Input;
 
 	std::vector<SpawnPoint>	mEnemySpawnPoints;
-	std::vector<Aircraft*> mActiveEnemies;
-	std::vector<Aircraft*> mActivePlayers;
 
 	BloomEffect	mBloomEffect;
 };
\ No newline at end of file